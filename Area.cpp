@@ -4,13 +4,11 @@
 
 namespace mtm {
 
-    bool compareGroups(const GroupPointer& group1, const GroupPointer& group2);
-
     /**
      * Class fields:
      *  std::string name;
      *  std::vector<GroupPointer> groups;
-     *  MtmSet<std::string> reachableAreas;
+     *  MtmHashSet<std::string, MtmStringHash, MtmStringEqual> reachableAreas;
      */
 
     Area::Area(const std::string& name) {
@@ -50,8 +48,16 @@ namespace mtm {
         }
     }
 
+    /**
+     * Sort the groups from the strongest to the weakest.
+     * Group::compare reads the power that every group caches, so the sort
+     * only moves the pointers, and only reads names on ties.
+     */
     void Area::sortByStrongest() {
-        std::sort(this->groups.begin(), this->groups.end(), compareGroups);
+        std::sort(this->groups.begin(), this->groups.end(),
+                  [](const GroupPointer& group1, const GroupPointer& group2) {
+            return group1->compare(*group2) > 0;
+        });
     }
 
     void Area::addReachableArea(const std::string& area_name) {
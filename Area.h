@@ -8,6 +8,8 @@
 #include "Clan.h"
 #include "Group.h"
 #include "MtmSet.h"
+#include "MtmHashSet.h"
+#include "MtmString.h"
 
 using std::string;
 using std::shared_ptr;
@@ -25,7 +27,7 @@ namespace mtm{
     protected:
         string name;
         std::vector<GroupPointer> groups;
-        MtmSet<string> reachableAreas;
+        MtmHashSet<string, MtmStringHash, MtmStringEqual> reachableAreas;
         const GroupPointer findGroup(const string &group_name) const;
         Clan& getNewGroupClan(const string &group_name, const string &clan,
                                map<string, Clan> &clan_map);
@@ -1,10 +1,39 @@
 #include <algorithm>
+#include <functional>
+#include <iterator>
 #include "Clan.h"
 #include "exceptions.h"
 
 namespace mtm{
 
-    bool compareGroups(const GroupPointer& group1, const GroupPointer& group2);
+    namespace {
+        /**
+         * Check if two indexes of groups share a key, in time linear in the
+         * size of the smaller one.
+         */
+        template<typename Index>
+        bool shareKey(const Index& index1, const Index& index2) {
+            const Index& smaller = index1.size() < index2.size() ?
+                                   index1 : index2;
+            const Index& bigger = &smaller == &index1 ? index2 : index1;
+            for (const typename Index::value_type& entry : smaller) {
+                if (bigger.count(entry.first) > 0) return true;
+            }
+            return false;
+        }
+
+        /**
+         * Move the entries of an index of groups into another one, copying
+         * only the smaller of the two.
+         */
+        template<typename Index>
+        void mergeIndex(Index& index, Index& other) {
+            if (other.size() > index.size()) index.swap(other);
+            index.reserve(index.size() + other.size());
+            index.insert(other.begin(), other.end());
+            other.clear();
+        }
+    }
 
     /**
      * Constructor
@@ -14,17 +43,45 @@ namespace mtm{
     Clan::Clan(const std::string& name){
         if (name.empty()) throw ClanEmptyName();
         this->name = name;
+        this->symbols = nullptr;
+        this->name_symbol = SymbolTable::EMPTY;
+        this->friendships = nullptr;
+        this->totals = GroupTotals();
+        this->ranked = true;
+        this->next_sharing = this;
+        this->previous_sharing = this;
     }
     
     /**
      * Copy constructor
+     * The groups are shared by the two clans. The copy builds its own
+     * index, totals and ranking, over its own list of the groups, and
+     * joins the ring of the other clan, so both are told about the
+     * changes of the groups.
      * @param other The clan to copy everything from.
      */
-    Clan::Clan(const Clan &other) : name(other.name), friends(other.friends) {
+    Clan::Clan(const Clan &other) : name(other.name), friends(other.friends),
+                                    totals(), ranked(true),
+                                    symbols(other.symbols),
+                                    name_symbol(other.name_symbol),
+                                    friendships(other.friendships),
+                                    next_sharing(this),
+                                    previous_sharing(this) {
+        this->joinSharing(*other.next_sharing);
         for (const GroupPointer& group : other.groups) {
             this->groups.push_back(group);
+            this->track(std::prev(this->groups.end()));
         }
     }
+
+    /**
+     * Destructor
+     * The groups that outlive the clan stop telling it about changes
+     * (another clan of the ring that has them is told instead).
+     */
+    Clan::~Clan() {
+        this->untrackAll();
+    }
     
     /**
      * Add a group (copy of it) to the clan
@@ -34,12 +91,289 @@ namespace mtm{
      * with the same name in the clan.
      */
     void Clan::addGroup(const Group& group){
-        if (group.getSize() == 0) throw ClanGroupIsEmpty();
-        if (this->doesContain(group.getName()))
+        this->insertGroup(std::make_shared<Group>(group));
+    }
+
+    /**
+     * Add a group to the clan, moving it instead of copying it.
+     * @param group The group to add to the clan
+     * @throws ClanGroupIsEmpty if the group has no people (empty)
+     * @throws ClanGroupNameAlreadyTaken if there is already a group
+     * with the same name in the clan.
+     */
+    void Clan::addGroup(Group&& group){
+        this->insertGroup(std::make_shared<Group>(std::move(group)));
+    }
+
+    void Clan::insertGroup(const GroupPointer& group){
+        if (group->getSize() == 0) throw ClanGroupIsEmpty();
+        if (this->doesContain(group->getName()))
             throw ClanGroupNameAlreadyTaken();
-        GroupPointer ptr(new Group(group));
-        this->groups.push_back(ptr);
-        ptr->changeClan(this->name);
+        if (this->symbols) group->intern(*this->symbols);
+        this->groups.push_back(group);
+        this->track(std::prev(this->groups.end()));
+        group->changeClan(this->name);
+    }
+
+    void Clan::track(GroupList::iterator position) {
+        Group& group = **position;
+        if (!group.listener) group.listener = this;
+        Place& place = this->places[&group];
+        place.position = position;
+        place.rank = this->ranking.end();
+        this->indexGroup(position);
+        this->applyChange(group, GroupTotals());
+        this->rerank(place);
+    }
+
+    void Clan::release(Group& group) {
+        if (group.listener != this) return;
+        group.listener = nullptr;
+        for (Clan* clan = this->next_sharing; clan != this;
+             clan = clan->next_sharing) {
+            if (clan->tracks(group)) {
+                group.listener = clan;
+                return;
+            }
+        }
+    }
+
+    void Clan::joinSharing(Clan& other) {
+        if (&other == this) return;
+        for (const Clan* clan = this->next_sharing; clan != this;
+             clan = clan->next_sharing) {
+            if (clan == &other) return;
+        }
+        Clan* next = this->next_sharing;
+        Clan* other_previous = other.previous_sharing;
+        this->next_sharing = &other;
+        other.previous_sharing = this;
+        other_previous->next_sharing = next;
+        next->previous_sharing = other_previous;
+    }
+
+    bool Clan::tracks(const Group& group) const {
+        return this->places.count(&group) > 0;
+    }
+
+    const std::string& Clan::Rank::getName() const {
+        if (this->symbols) return this->symbols->name(this->symbol);
+        return this->name;
+    }
+
+    bool Clan::Rank::operator<(const Rank& other) const {
+        if (this->power != other.power) return this->power > other.power;
+        if (!this->symbols || this->symbols != other.symbols
+            || this->symbol != other.symbol) {
+            int order = this->getName().compare(other.getName());
+            if (order != 0) return order > 0;
+        }
+        return this->position->get() < other.position->get();
+    }
+
+    Clan::Rank Clan::rankOf(GroupList::const_iterator position) {
+        const Group& group = **position;
+        Rank rank = {group.getTotals().power, group.symbols,
+                     group.getNameSymbol(), std::string(), position};
+        if (!group.symbols) rank.name = group.getName();
+        return rank;
+    }
+
+    void Clan::adopt(Group& group) {
+        GroupTotals before = group.getTotals();
+        bool interned = this->symbols && group.symbols == this->symbols;
+        group.moveToClan(this->name, interned ? this->name_symbol
+                                              : SymbolTable::NOT_FOUND);
+        this->totals.power += group.power - before.power;
+        for (Clan* clan = this->next_sharing; clan != this;
+             clan = clan->next_sharing) {
+            clan->applyChange(group, before);
+        }
+    }
+
+    void Clan::rerank(Place& place) {
+        if (!this->ranked) return;
+        if (place.rank != this->ranking.end()) {
+            this->ranking.erase(place.rank);
+            place.rank = this->ranking.end();
+        }
+        if ((*place.position)->getName().empty()) return;
+        place.rank = this->ranking.insert(rankOf(place.position)).first;
+    }
+
+    void Clan::untrackAll() {
+        for (const GroupPointer& group : this->groups) this->release(*group);
+        this->next_sharing->previous_sharing = this->previous_sharing;
+        this->previous_sharing->next_sharing = this->next_sharing;
+        this->next_sharing = this;
+        this->previous_sharing = this;
+        this->places.clear();
+        this->totals = GroupTotals();
+        this->ranking.clear();
+        this->ranked = true;
+    }
+
+    void Clan::rankAll() const {
+        if (this->ranked) return;
+        std::vector<Rank> sorted;
+        sorted.reserve(this->index.size());
+        for (GroupList::const_iterator itr = this->groups.begin();
+             itr != this->groups.end(); ++itr) {
+            this->places.at(itr->get()).rank = this->ranking.end();
+            if ((*itr)->getName().empty()) continue;
+            sorted.push_back(rankOf(itr));
+        }
+        std::sort(sorted.begin(), sorted.end());
+        for (Rank& rank : sorted) {
+            Place& place = this->places.at(rank.position->get());
+            place.rank = this->ranking.insert(this->ranking.end(),
+                                              std::move(rank));
+        }
+        this->ranked = true;
+    }
+
+    void Clan::groupChanged(const Group& group, const GroupTotals& before) {
+        Clan* clan = this;
+        do {
+            clan->applyChange(group, before);
+            clan = clan->next_sharing;
+        } while (clan != this);
+    }
+
+    void Clan::groupRenamed(const Group& group, const std::string& old_name) {
+        Clan* clan = this;
+        do {
+            clan->applyRename(group, old_name);
+            clan = clan->next_sharing;
+        } while (clan != this);
+    }
+
+    void Clan::applyChange(const Group& group, const GroupTotals& before) {
+        GroupPlaces::iterator found = this->places.find(&group);
+        if (found == this->places.end()) return;
+        GroupTotals after = group.getTotals();
+        this->totals.people += after.people - before.people;
+        this->totals.tools += after.tools - before.tools;
+        this->totals.food += after.food - before.food;
+        this->totals.power += after.power - before.power;
+        if (after.power != before.power && this->ranked
+            && found->second.rank != this->ranking.end()) {
+            this->rerank(found->second);
+        }
+    }
+
+    void Clan::applyRename(const Group& group, const std::string& old_name) {
+        GroupPlaces::iterator found = this->places.find(&group);
+        if (found == this->places.end()) return;
+        GroupList::const_iterator position = found->second.position;
+        this->unindexGroup(position, old_name);
+        this->rerank(found->second);
+        this->indexGroup(position);
+    }
+
+    /**
+     * Intern the name of the clan, and the names of all its groups, in
+     * a table. Groups that are added later are interned too.
+     * The table must outlive the clan and its groups.
+     * @param table The table.
+     */
+    void Clan::intern(SymbolTable& table) {
+        this->symbols = &table;
+        this->name_symbol = table.intern(this->name);
+        this->index.clear();
+        for (GroupList::const_iterator itr = this->groups.begin();
+             itr != this->groups.end(); ++itr) {
+            (*itr)->intern(table);
+            this->indexGroup(itr);
+        }
+    }
+
+    /**
+     * Keep the friendships of the clan with the other clans of a graph
+     * in the graph, where they are checked in constant time, and merged
+     * in time linear in the amount of friends when clans unite.
+     * The clan must be interned first (the symbol of its name is its
+     * node in the graph), and the other clans of the graph must be
+     * interned in the same table. If the clan isn't interned, does
+     * nothing. The graph must outlive the clan.
+     * @param graph The graph.
+     */
+    void Clan::joinFriendships(FriendshipGraph& graph) {
+        if (!this->symbols) return;
+        this->friendships = &graph;
+        graph.add(this->name_symbol);
+    }
+
+    bool Clan::sharesGraph(const Clan& other) const {
+        return this->friendships && this->friendships == other.friendships
+               && this->symbols == other.symbols;
+    }
+
+    bool Clan::sharesKeys(const Clan& other) const {
+        return this->symbols == other.symbols;
+    }
+
+    bool Clan::GroupKey::operator==(const GroupKey& other) const {
+        return this->symbol == other.symbol && this->name == other.name;
+    }
+
+    std::size_t Clan::GroupKeyHash::operator()(const GroupKey& key) const {
+        if (key.symbol != SymbolTable::NOT_FOUND) {
+            return std::hash<SymbolTable::Symbol>()(key.symbol);
+        }
+        return MtmStringHash()(key.name);
+    }
+
+    Clan::GroupKey Clan::keyOf(const std::string& group_name) const {
+        GroupKey key = {SymbolTable::NOT_FOUND, std::string()};
+        if (this->symbols) {
+            key.symbol = this->symbols->find(group_name);
+        } else {
+            key.name = group_name;
+        }
+        return key;
+    }
+
+    Clan::GroupKey Clan::keyOf(const Group& group) {
+        GroupKey key = {SymbolTable::NOT_FOUND, std::string()};
+        if (!this->symbols) {
+            key.name = group.getName();
+        } else if (group.symbols == this->symbols) {
+            key.symbol = group.name_symbol;
+        } else {
+            key.symbol = this->symbols->intern(group.getName());
+        }
+        return key;
+    }
+
+    Clan::GroupList::const_iterator Clan::findGroup(
+            const std::string& group_name) const {
+        GroupIndex::const_iterator entry =
+                this->index.find(this->keyOf(group_name));
+        if (entry == this->index.end()) return this->groups.end();
+        return entry->second;
+    }
+
+    void Clan::indexGroup(GroupList::const_iterator position) {
+        this->index[this->keyOf(**position)] = position;
+    }
+
+    void Clan::unindexGroup(GroupList::const_iterator position,
+                            const std::string& group_name) {
+        GroupIndex::iterator entry = this->index.find(this->keyOf(group_name));
+        /* Another group may have taken the name first (like in
+         * Group::unite) */
+        if (entry == this->index.end() || entry->second != position) return;
+        this->index.erase(entry);
+        if (!group_name.empty()) return;
+        /* Other groups that lost their people take the empty name over */
+        for (GroupList::const_iterator itr = this->groups.begin();
+             itr != this->groups.end(); ++itr) {
+            if (itr != position && (*itr)->getName().empty()) {
+                this->indexGroup(itr);
+                return;
+            }
+        }
     }
 
     /**
@@ -51,23 +385,13 @@ namespace mtm{
      */
     const GroupPointer& Clan::getGroup(const std::string& group_name) const{
         if (group_name.empty()) throw ClanGroupNotFound();
-        std::list<GroupPointer>::const_iterator itr = this->groups.begin();
-        for ( ; itr != groups.end(); ++itr) {
-            if ((*itr)->getName() == group_name) {
-                return *itr;
-            }
-        }
-        throw ClanGroupNotFound();
+        GroupList::const_iterator itr = this->findGroup(group_name);
+        if (itr == this->groups.end()) throw ClanGroupNotFound();
+        return *itr;
     }
 
     bool Clan::doesContain(const std::string& group_name) const{
-        std::list<GroupPointer>::const_iterator itr = this->groups.begin();
-        for ( ; itr != groups.end(); ++itr) {
-            if ((*itr)->getName() == group_name) {
-                return true;
-            }
-        }
-        return false;
+        return this->findGroup(group_name) != this->groups.end();
     }
 
     /**
@@ -77,17 +401,46 @@ namespace mtm{
      * @return The amount of people in the clan.
      */
     int Clan::getSize() const{
-        int total_size = 0;
-        std::list<GroupPointer>::const_iterator itr = this->groups.begin();
-        for ( ; itr != groups.end(); ++itr) {
-            total_size += (*itr)->getSize();
+        return int(this->totals.people);
+    }
+
+    /**
+     * Get the sums of the people, tools, food and power of the groups
+     * of the clan, in constant time.
+     * @return The totals of the clan.
+     */
+    GroupTotals Clan::getTotals() const{
+        return this->totals;
+    }
+
+    /**
+     * Get the strongest groups of the clan, by the groups comparison
+     * operators, without sorting them.
+     * @param count The amount of groups to get.
+     * @return The count strongest groups, from the strongest to the
+     *  weakest (or all the groups with people, if there are fewer).
+     */
+    std::vector<GroupPointer> Clan::getStrongestGroups(std::size_t count)
+            const{
+        this->rankAll();
+        std::vector<GroupPointer> strongest;
+        strongest.reserve(std::min(count, this->ranking.size()));
+        for (Ranking::const_iterator itr = this->ranking.begin();
+             itr != this->ranking.end() && strongest.size() < count; ++itr) {
+            strongest.push_back(*itr->position);
         }
-        return total_size;
+        return strongest;
     }
 
     /**
      * Make two clans unite, to form a new clan, with a new name. All the
      * groups of each clan will change their clan.
+     * The groups of the other clan are spliced into this clan, and the
+     * groups that change their clan are updated in one pass, so the
+     * time is linear in the amount of groups that change their clan
+     * (or in the amount of groups of this clan, if the ranking has to be
+     * built again later), and in the amount of groups of the smaller
+     * clan (for its index).
      * The friends of the new clan are all the friends of either one of
      * the old 2 clans.
      * The new clan will replace this clan, and the other clan (received
@@ -108,26 +461,74 @@ namespace mtm{
     Clan& Clan::unite(Clan& other, const std::string& new_name){
         if (new_name.empty()) throw ClanEmptyName();
         if (this == &other) throw ClanCantUnite();
-        for(const GroupPointer& ptr : this->groups) {
-            if (other.doesContain(ptr->getName())) {
-                throw ClanCantUnite();
+        if (this->sharesKeys(other)) {
+            if (shareKey(this->index, other.index)) throw ClanCantUnite();
+        } else {
+            const Clan& smaller = this->index.size() < other.index.size() ?
+                                  *this : other;
+            const Clan& bigger = &smaller == this ? other : *this;
+            for (const GroupPointer& group : smaller.groups) {
+                if (bigger.doesContain(group->getName())) throw ClanCantUnite();
             }
         }
-        if (new_name != this->name) {
-            for (std::list<GroupPointer>::const_iterator itr
-                    = this->groups.begin(); itr != this->groups.end(); ++itr) {
-                (*itr)->changeClan(new_name);
+        bool renamed = new_name != this->name;
+        SymbolTable::Symbol old_symbol = this->name_symbol;
+        this->name = new_name;
+        if (this->symbols) this->name_symbol = this->symbols->intern(new_name);
+        if (this->friendships) {
+            /* The node of the clan changes with its name, and takes the
+             * friends of the other clan */
+            this->friendships->merge(this->name_symbol, old_symbol);
+            if (this->sharesGraph(other)) {
+                this->friendships->merge(this->name_symbol, other.name_symbol);
             }
         }
-        this->name = new_name;
-        for(std::list<GroupPointer>::const_iterator itr
-                = other.groups.begin(); itr != other.groups.end(); ++itr) {
-            if ((**itr).getSize() > 0) {
-                this->groups.push_back(*itr);
-                (**itr).changeClan(this->name);
+        if (renamed || other.groups.size() >= this->ranking.size()) {
+            /* Cheaper to sort all the groups once than to move them one by
+             * one in the ranking */
+            this->ranking.clear();
+            this->ranked = false;
+        }
+        if (renamed) {
+            for (const GroupPointer& group : this->groups) this->adopt(*group);
+        }
+        /* The groups of the other clan move over without copying, and stay
+         * in the same positions, so the entries of its index stay valid if
+         * it has the same keys. The smaller index is the one that is
+         * copied. */
+        GroupList::iterator joined = other.groups.empty() ?
+                                     this->groups.end() : other.groups.begin();
+        this->groups.splice(this->groups.end(), other.groups);
+        this->joinSharing(other);
+        bool same_keys = this->sharesKeys(other);
+        /* The groups of the other clan that lost their people stay behind */
+        other.index.erase(other.keyOf(std::string()));
+        if (same_keys) mergeIndex(this->index, other.index);
+        this->places.reserve(this->places.size() + other.places.size());
+        other.index.clear();
+        other.places.clear();
+        other.totals = GroupTotals();
+        other.ranking.clear();
+        while (joined != this->groups.end()) {
+            Group& group = **joined;
+            if (group.getSize() == 0) {
+                other.release(group);
+                joined = this->groups.erase(joined);
+                continue;
             }
+            if (this->symbols) group.intern(*this->symbols);
+            if (group.listener == &other) group.listener = this;
+            Place& place = this->places[&group];
+            place.position = joined;
+            place.rank = this->ranking.end();
+            if (!same_keys) this->indexGroup(joined);
+            this->applyChange(group, GroupTotals());
+            this->adopt(group);
+            this->rerank(place);
+            ++joined;
         }
-        for(MtmSet<Clan*>::const_iterator itr = other.friends.begin();
+        for(MtmSet<Clan*, INLINE_FRIENDS>::const_iterator itr
+                = other.friends.begin();
             itr != other.friends.end(); ++itr) {
             if (*itr != this) this->makeFriend(**itr);
             other.removeFriend(**itr);
@@ -143,8 +544,11 @@ namespace mtm{
     */
     void Clan::clear(){
         this->name = "";
+        this->name_symbol = SymbolTable::EMPTY;
         this->friends.clear();
+        this->untrackAll();
         this->groups.clear();
+        this->index.clear();
     }
 
     /**
@@ -156,6 +560,11 @@ namespace mtm{
      */
     void Clan::makeFriend(Clan& other){
         if (this->isFriend(other)) return;
+        if (this->sharesGraph(other)) {
+            this->friendships->makeFriends(this->name_symbol,
+                                           other.name_symbol);
+            return;
+        }
         this->friends.insert(&other);
         other.friends.insert(this);
     }
@@ -169,18 +578,49 @@ namespace mtm{
      */
     bool Clan::isFriend(const Clan& other) const{
         if (this == &other) return true;
+        if (this->sharesGraph(other)) {
+            return this->friendships->areFriends(this->name_symbol,
+                                                 other.name_symbol);
+        }
         for(Clan* curr : this->friends){
             if (curr->isEqual(other)) return true;
         }
         return false;
     }
 
+    /**
+     * Check if the clan of a given group is a friend of this clan,
+     * without looking up the clan of the group.
+     * @param group The group whose clan to check.
+     * @return true, if the clan of the group is a friend of this clan (or
+     *  is this clan), false otherwise.
+     */
+    bool Clan::isFriend(const Group& group) const{
+        if (this->symbols && this->symbols == group.symbols) {
+            if (this->friendships
+                && this->friendships->areFriends(this->name_symbol,
+                                                 group.clan_symbol)) {
+                return true;
+            }
+            if (group.clan_symbol == this->name_symbol) return true;
+        } else if (group.getClan() == this->name) {
+            return true;
+        }
+        for(Clan* curr : this->friends){
+            if (curr->name == group.getClan()) return true;
+        }
+        return false;
+    }
+
     /**
      * Checks whether the two clans have the same name.
      * @param other the clan to check with
      * @return true is yes and false if not.
      */
     bool Clan::isEqual(const Clan& other) const{
+        if (this->symbols && this->symbols == other.symbols) {
+            return this->name_symbol == other.name_symbol;
+        }
         return this->name == other.name;
     }
 
@@ -191,7 +631,7 @@ namespace mtm{
      * Note: is asymmetrical
      * @param friend that should be removed
      */
-    void Clan::removeFriend(Clan other){
+    void Clan::removeFriend(Clan& other){
         for(Clan* curr : other.friends) {
             if (curr == this) {
                 other.friends.erase(this);
@@ -217,21 +657,14 @@ namespace mtm{
      * @return A reference to the output stream
      */
     std::ostream& operator<<(std::ostream& os, const Clan& clan){
-        std::list<GroupPointer> copied(clan.groups);
-        copied.sort(compareGroups);
         os << "Clan's name: " << clan.name << std::endl
            << "Clan's groups:" << std::endl;
-        std::list<GroupPointer>::const_iterator itr = copied.begin();
-        for ( ; itr != copied.end(); ++itr) {
-            if ((*itr)->getSize() == 0) continue;
-            os << (*itr)->getName() << std::endl;
+        clan.rankAll();
+        for (const Clan::Rank& rank : clan.ranking) {
+            os << rank.getName() << std::endl;
         }
         return os;
     }
-    
-    bool compareGroups(const GroupPointer& group1, const GroupPointer& group2){
-        return *group1 > *group2;
-    }
 }
 
 
@@ -3,10 +3,16 @@
 
 #include <string>
 #include "Group.h"
+#include "FriendshipGraph.h"
 #include <ostream>
 #include <memory>
+#include <utility>
 #include "MtmSet.h"
+#include "MtmString.h"
 #include <list>
+#include <set>
+#include <unordered_map>
+#include <vector>
 
 
 namespace mtm{
@@ -18,11 +24,276 @@ namespace mtm{
      * friends to other clans.
      * Groups with no people can't join a clan, and a group that had
      * lost all of its people, will be removed from the clan.
+     * The clan is a listener of its groups, so it can find them by name,
+     * and sum up their numbers, in constant time, and keep them ordered by
+     * strength. A group tells only one clan about its changes, and that
+     * clan passes them on to the copies it shares the group with.
      */
-    class Clan{
+    class Clan : private GroupListener{
+        /**
+         * Most clans have only a few friends, so that many are stored
+         * inside the clan object, without allocations.
+         */
+        static const std::size_t INLINE_FRIENDS = 8;
+
+        typedef std::list<GroupPointer> GroupList;
+
+        /**
+         * The key of a group in the index: the symbol of its name, when the
+         * clan is interned (and name is empty), or its name, when it isn't
+         * (and symbol is NOT_FOUND).
+         */
+        struct GroupKey{
+            SymbolTable::Symbol symbol;
+            std::string name;
+
+            bool operator==(const GroupKey& other) const;
+        };
+        struct GroupKeyHash{
+            std::size_t operator()(const GroupKey& key) const;
+        };
+        typedef std::unordered_map<GroupKey, GroupList::const_iterator,
+                GroupKeyHash> GroupIndex;
+
+        /**
+         * The place of a group in the ranking: its power and name when it
+         * was ranked, and its position in groups.
+         * The name of an interned group is kept as its symbol (and name is
+         * empty), so it is never copied, and only read on ties of power.
+         */
+        struct Rank{
+            std::int64_t power;
+            const SymbolTable* symbols;
+            SymbolTable::Symbol symbol;
+            std::string name;
+            GroupList::const_iterator position;
+
+            /**
+             * @return The name of the group when it was ranked.
+             */
+            const std::string& getName() const;
+
+            /**
+             * Stronger groups come first, as in Group::compare (by power, and
+             * then by name). Groups with the same power and name are
+             * ordered by address.
+             */
+            bool operator<(const Rank& other) const;
+        };
+        typedef std::set<Rank> Ranking;
+
+        /**
+         * Where a group of the clan is kept: its position in groups, and
+         * its rank in the ranking (ranking.end() if it isn't ranked). The
+         * rank is only meaningful while the ranking is kept (ranked is
+         * true).
+         */
+        struct Place{
+            GroupList::const_iterator position;
+            Ranking::iterator rank;
+        };
+        typedef std::unordered_map<const Group*, Place> GroupPlaces;
+
         std::string name;
-        std::list<GroupPointer> groups;
-        MtmSet<Clan*> friends;
+        GroupList groups;
+        MtmSet<Clan*, INLINE_FRIENDS> friends;
+
+        /**
+         * The groups of the clan by the keys of their names. Groups that
+         * lost all their people (and their name) are in it by the empty
+         * name, like any other name (the entry is of one of them). Kept up
+         * to date by groupRenamed.
+         */
+        GroupIndex index;
+
+        /**
+         * The sums of the totals of the groups of the clan. Kept up to date
+         * by groupChanged.
+         */
+        GroupTotals totals;
+
+        /**
+         * The groups of the clan from the strongest to the weakest. Groups
+         * that lost all their people aren't ranked. Kept up to date by
+         * rerank while ranked is true. A unite that moves as many groups as
+         * are ranked drops the ranking (ranked becomes false), and it is
+         * built again at once by rankAll the next time it is needed.
+         */
+        mutable Ranking ranking;
+        mutable bool ranked;
+
+        /**
+         * The place of every group of the clan, with or without a name, so
+         * a group that tells the clan about a change is found, in groups
+         * and in the ranking, in constant time. The ranks are set by
+         * rankAll, so it is mutable.
+         */
+        mutable GroupPlaces places;
+
+        /**
+         * The table that the names of the clan and of its groups are
+         * interned in, or nullptr.
+         */
+        SymbolTable* symbols;
+        SymbolTable::Symbol name_symbol;
+
+        /**
+         * The graph that the friendships of the clan with other clans of the
+         * graph are kept in, or nullptr. Friendships with clans outside of
+         * the graph are kept in friends.
+         */
+        FriendshipGraph* friendships;
+
+        /**
+         * The clans that may share groups with this clan (its copies, and
+         * the clans they united with), in a ring, linked by next_sharing
+         * and previous_sharing. A clan that shares nothing is alone in its
+         * ring. Only one of them is the listener of a shared group, and
+         * it passes the changes of the group on to the others that have
+         * the group. Changed by copies of the clan, so it is mutable.
+         */
+        mutable Clan* next_sharing;
+        mutable Clan* previous_sharing;
+
+        /**
+         * @return true if the friendship between this clan and another one
+         *  is kept in a graph, false if it is kept in friends.
+         */
+        bool sharesGraph(const Clan& other) const;
+
+        /**
+         * @return true if the groups of this clan and of another one are
+         *  indexed by the same keys: both by symbols of the same table, or
+         *  both by names.
+         */
+        bool sharesKeys(const Clan& other) const;
+
+        /**
+         * @return The key of a name in the index. A name that isn't in the
+         *  table of an interned clan gets a key that no group has.
+         */
+        GroupKey keyOf(const std::string& group_name) const;
+
+        /**
+         * @return The key of the current name of a group in the index,
+         *  interning it in the table of the clan if it isn't yet.
+         */
+        GroupKey keyOf(const Group& group);
+
+        /**
+         * Find a group in the clan, in the index.
+         * @return An iterator to the group, or groups.end().
+         */
+        GroupList::const_iterator findGroup(
+                const std::string& group_name) const;
+
+        /**
+         * Add a group to the index, by its current name.
+         * @param position The position of the group in groups.
+         */
+        void indexGroup(GroupList::const_iterator position);
+
+        /**
+         * Remove a group from the index, if it is there by a given name.
+         * @param position The position of the group in groups.
+         * @param group_name The name it may be indexed by.
+         */
+        void unindexGroup(GroupList::const_iterator position,
+                          const std::string& group_name);
+
+        /**
+         * @param position The position of a group in groups.
+         * @return The rank of the group by its current power and name.
+         */
+        static Rank rankOf(GroupList::const_iterator position);
+
+        /**
+         * Add a group of the clan to the index, to the places, to the
+         * totals and to the ranking, and listen to it if no clan of the
+         * ring does.
+         * @param position The position of the group in groups.
+         */
+        void track(GroupList::iterator position);
+
+        /**
+         * Stop tracking the groups of the clan, and leave the ring. The
+         * groups that the clan listens to are listened to by another clan
+         * of the ring that has them, if there is one. The totals become 0,
+         * and the ranking and the places become empty.
+         */
+        void untrackAll();
+
+        /**
+         * Stop listening to a group, and let another clan of the ring that
+         * has the group listen to it, if there is one. If the clan doesn't
+         * listen to the group, does nothing.
+         * @param group The group.
+         */
+        void release(Group& group);
+
+        /**
+         * Make the ring of this clan and the ring of another clan one ring,
+         * if they aren't already.
+         * @param other The other clan, or any clan of its ring.
+         */
+        void joinSharing(Clan& other);
+
+        /**
+         * @return true if the clan has a group (by address).
+         */
+        bool tracks(const Group& group) const;
+
+        /**
+         * Move a group of the clan to the clan, like Group::changeClan, and
+         * update the power total without telling groupChanged. The ranking
+         * isn't updated. The other clans of the ring are told.
+         * @param group The group.
+         */
+        void adopt(Group& group);
+
+        /**
+         * Move a group to its place in the ranking, by its current power
+         * and name. If the ranking was dropped, does nothing.
+         * @param place The place of the group.
+         */
+        void rerank(Place& place);
+
+        /**
+         * Build the ranking again, if it was dropped, by sorting the groups
+         * once.
+         */
+        void rankAll() const;
+
+        /**
+         * Move a group in the index from its old name to its new one, and
+         * in the ranking. If the clan doesn't have the group, does nothing.
+         */
+        void applyRename(const Group& group, const std::string& old_name);
+
+        /**
+         * Update the totals of the clan with the change of a group, and
+         * move the group in the ranking. If the clan doesn't have the
+         * group, does nothing.
+         */
+        void applyChange(const Group& group, const GroupTotals& before);
+
+        /**
+         * Apply the rename of a group in every clan of the ring.
+         */
+        void groupRenamed(const Group& group,
+                          const std::string& old_name) override;
+
+        /**
+         * Apply the change of a group in every clan of the ring.
+         */
+        void groupChanged(const Group& group,
+                          const GroupTotals& before) override;
+
+        /**
+         * Add a new group to the clan, that no one else points to.
+         * @throws The exceptions of addGroup.
+         */
+        void insertGroup(const GroupPointer& group);
 
 
         /**
@@ -31,7 +302,7 @@ namespace mtm{
          * Note: is asymmetrical
          * @param other that should be removed
          */
-        void removeFriend(Clan other);
+        void removeFriend(Clan& other);
 
         /**
          * Clears a clan. makes name empty.
@@ -58,6 +329,10 @@ namespace mtm{
         
         /**
          * Copy constructor.
+         * The groups are shared by the two clans. The copy builds its own
+         * index, totals and ranking, over its own list of the groups, and
+         * joins the ring of the other clan, so both are told about the
+         * changes of the groups.
          */
         Clan(const Clan& other);
 
@@ -68,8 +343,30 @@ namespace mtm{
         
         /**
          * Destructor
+         * The groups that outlive the clan stop telling it about changes
+         * (another clan of the ring that has them is told instead).
+         */
+        ~Clan();
+
+        /**
+         * Intern the name of the clan, and the names of all its groups, in
+         * a table. Groups that are added later are interned too.
+         * The table must outlive the clan and its groups.
+         * @param table The table.
+         */
+        void intern(SymbolTable& table);
+
+        /**
+         * Keep the friendships of the clan with the other clans of a graph
+         * in the graph, where they are checked in constant time, and merged
+         * in time linear in the amount of friends when clans unite.
+         * The clan must be interned first (the symbol of its name is its
+         * node in the graph), and the other clans of the graph must be
+         * interned in the same table. If the clan isn't interned, does
+         * nothing. The graph must outlive the clan.
+         * @param graph The graph.
          */
-        ~Clan() = default;
+        void joinFriendships(FriendshipGraph& graph);
         
         /**
          * Add a group (copy of it) to the clan
@@ -79,6 +376,30 @@ namespace mtm{
          * with the same name in the clan.
          */
         void addGroup(const Group& group);
+
+        /**
+         * Add a group to the clan, moving it instead of copying it.
+         * @param group The group to add to the clan
+         * @throws ClanGroupIsEmpty if the group has no people (empty)
+         * @throws ClanGroupNameAlreadyTaken if there is already a group
+         * with the same name in the clan.
+         */
+        void addGroup(Group&& group);
+
+        /**
+         * Add a new group to the clan, constructed in place (with a single
+         *  allocation) from the arguments of a Group constructor.
+         * @param args The arguments for the constructor of the group.
+         * @throws GroupInvalidArgs If the arguments are invalid for Group.
+         * @throws ClanGroupIsEmpty if the group has no people (empty)
+         * @throws ClanGroupNameAlreadyTaken if there is already a group
+         * with the same name in the clan.
+         */
+        template<typename... Args>
+        void emplaceGroup(Args&&... args) {
+            this->insertGroup(std::make_shared<Group>(
+                    std::forward<Args>(args)...));
+        }
         
         /**
          * Get a group from the clan, with a given name
@@ -98,10 +419,32 @@ namespace mtm{
          * @return The amount of people in the clan.
          */
         int getSize() const;
+
+        /**
+         * Get the sums of the people, tools, food and power of the groups
+         * of the clan, in constant time.
+         * @return The totals of the clan.
+         */
+        GroupTotals getTotals() const;
+
+        /**
+         * Get the strongest groups of the clan, by the groups comparison
+         * operators, without sorting them.
+         * @param count The amount of groups to get.
+         * @return The count strongest groups, from the strongest to the
+         *  weakest (or all the groups with people, if there are fewer).
+         */
+        std::vector<GroupPointer> getStrongestGroups(std::size_t count) const;
         
         /**
          * Make two clans unite, to form a new clan, with a new name. All the
          * groups of each clan will change their clan.
+         * The groups of the other clan are spliced into this clan, and the
+         * groups that change their clan are updated in one pass, so the
+         * time is linear in the amount of groups that change their clan
+         * (or in the amount of groups of this clan, if the ranking has to be
+         * built again later), and in the amount of groups of the smaller
+         * clan (for its index).
          * The friends of the new clan are all the friends of either one of
          * the old 2 clans.
          * The new clan will replace this clan, and the other clan (received
@@ -138,10 +481,20 @@ namespace mtm{
          *  otherwise.
          */
         bool isFriend(const Clan& other) const;
+
+        /**
+         * Check if the clan of a given group is a friend of this clan,
+         * without looking up the clan of the group.
+         * @param group The group whose clan to check.
+         * @return true, if the clan of the group is a friend of this clan (or
+         *  is this clan), false otherwise.
+         */
+        bool isFriend(const Group& group) const;
         
         /**
          * Print The clan name, and it groups, sorted by groups comparison
-         * operators, from strongest to weakest. In the next Format:
+         * operators, from strongest to weakest (in the order they are kept
+         * in, so nothing is sorted). In the next Format:
          *
          * Clan's name: [name]
          *     [1'st group name]
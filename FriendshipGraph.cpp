@@ -0,0 +1,140 @@
+#include <utility>
+#include "FriendshipGraph.h"
+
+namespace mtm{
+
+    /**
+     * Add a clan with no friends to the graph. If the clan is already
+     * in the graph, does nothing.
+     * @param clan The clan.
+     */
+    void FriendshipGraph::add(Node clan) {
+        if (this->vertices.count(clan) > 0) return;
+        Vertex& vertex = this->vertices[clan];
+        vertex.element = this->parents.size();
+        this->parents.push_back(vertex.element);
+        this->sizes.push_back(1);
+    }
+
+    bool FriendshipGraph::contains(Node clan) const {
+        return this->vertices.count(clan) > 0;
+    }
+
+    /**
+     * Make two clans friends, adding them to the graph if they aren't
+     * in it. If they already were friends, does nothing.
+     * @param clan1 One of the clans.
+     * @param clan2 The other clan.
+     */
+    void FriendshipGraph::makeFriends(Node clan1, Node clan2) {
+        this->add(clan1);
+        this->add(clan2);
+        if (clan1 == clan2) return;
+        Vertex& vertex1 = this->vertices[clan1];
+        Vertex& vertex2 = this->vertices[clan2];
+        vertex1.friends.insert(clan2);
+        vertex2.friends.insert(clan1);
+        this->unionRoots(vertex1.element, vertex2.element);
+    }
+
+    /**
+     * Check if two clans are friends, in constant time.
+     * Every clan is a friend of itself.
+     * @param clan1 One of the clans.
+     * @param clan2 The other clan.
+     * @return true if the clans are friends, false otherwise.
+     */
+    bool FriendshipGraph::areFriends(Node clan1, Node clan2) const {
+        if (clan1 == clan2) return true;
+        std::unordered_map<Node, Vertex>::const_iterator vertex =
+                this->vertices.find(clan1);
+        return vertex != this->vertices.end()
+               && vertex->second.friends.count(clan2) > 0;
+    }
+
+    /**
+     * Merge a clan into another one, in time linear in the amount of
+     * friends of the merged clan: its friends become friends of the other
+     * clan, and it is removed from the graph. If the two were friends,
+     * the friendship is removed.
+     * @param into The clan that stays, added to the graph if it isn't in it.
+     * @param from The clan that is merged. If it is into, or isn't in the
+     *  graph, nothing changes.
+     */
+    void FriendshipGraph::merge(Node into, Node from) {
+        if (into == from || this->vertices.count(from) == 0) return;
+        this->add(into);
+        Vertex& into_vertex = this->vertices[into];
+        Vertex& from_vertex = this->vertices[from];
+        for (Node clan : from_vertex.friends) {
+            std::unordered_set<Node>& friends = this->vertices[clan].friends;
+            friends.erase(from);
+            if (clan == into) continue;
+            friends.insert(into);
+            into_vertex.friends.insert(clan);
+        }
+        this->unionRoots(into_vertex.element, from_vertex.element);
+        this->vertices.erase(from);
+    }
+
+    /**
+     * Check if two clans are allies, in time logarithmic in the amount
+     * of clans.
+     * @param clan1 One of the clans.
+     * @param clan2 The other clan.
+     * @return true if both clans are in the graph, and are connected by
+     *  a chain of friendships (or are the same clan), false otherwise.
+     */
+    bool FriendshipGraph::areAllies(Node clan1, Node clan2) const {
+        std::unordered_map<Node, Vertex>::const_iterator vertex1 =
+                this->vertices.find(clan1);
+        std::unordered_map<Node, Vertex>::const_iterator vertex2 =
+                this->vertices.find(clan2);
+        if (vertex1 == this->vertices.end()
+            || vertex2 == this->vertices.end()) {
+            return false;
+        }
+        return this->findRoot(vertex1->second.element)
+               == this->findRoot(vertex2->second.element);
+    }
+
+    std::size_t FriendshipGraph::findRoot(std::size_t element) const {
+        while (this->parents[element] != element) {
+            element = this->parents[element];
+        }
+        return element;
+    }
+
+    void FriendshipGraph::unionRoots(std::size_t element1,
+                                     std::size_t element2) {
+        std::size_t root1 = this->findRoot(element1);
+        std::size_t root2 = this->findRoot(element2);
+        if (root1 == root2) return;
+        /* Union by size, so every path is at most logarithmic */
+        if (this->sizes[root1] < this->sizes[root2]) std::swap(root1, root2);
+        this->parents[root2] = root1;
+        this->sizes[root1] += this->sizes[root2];
+    }
+
+    /**
+     * @return Every alliance of the graph, as the clans in it (in no
+     *  particular order).
+     */
+    std::vector<std::vector<FriendshipGraph::Node>>
+    FriendshipGraph::getAlliances() const {
+        std::unordered_map<std::size_t, std::size_t> positions;
+        std::vector<std::vector<Node>> alliances;
+        for (const std::pair<const Node, Vertex>& vertex : this->vertices) {
+            std::size_t root = this->findRoot(vertex.second.element);
+            std::unordered_map<std::size_t, std::size_t>::iterator position =
+                    positions.find(root);
+            if (position == positions.end()) {
+                position = positions.insert(std::make_pair(
+                        root, alliances.size())).first;
+                alliances.push_back(std::vector<Node>());
+            }
+            alliances[position->second].push_back(vertex.first);
+        }
+        return alliances;
+    }
+}
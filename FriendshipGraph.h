@@ -0,0 +1,118 @@
+#ifndef MTM4_FRIENDSHIP_GRAPH_H
+#define MTM4_FRIENDSHIP_GRAPH_H
+
+#include <cstddef>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "SymbolTable.h"
+
+namespace mtm{
+
+    /**
+     * The friendships between the clans of a world. Every clan is a node,
+     * named by the symbol of the name of the clan, and every friendship is
+     * an edge.
+     * Two clans are allies if they are connected by a chain of
+     * friendships. The alliances are kept in a union-find forest, which is
+     * possible since a friendship is only ever removed when its clan unites
+     * with another one, and then the allies of both become allies of the
+     * united clan. Every clan that is added gets a new element of the
+     * forest, so a name that is used again doesn't inherit old alliances.
+     */
+    class FriendshipGraph{
+    public:
+        typedef SymbolTable::Symbol Node;
+
+    private:
+        /**
+         * A clan in the graph: its friends (possibly none), and its element
+         * in the forest.
+         */
+        struct Vertex{
+            std::unordered_set<Node> friends;
+            std::size_t element;
+        };
+
+        std::unordered_map<Node, Vertex> vertices;
+
+        /**
+         * The union-find forest of the alliances: the parent of every
+         * element (a root is its own parent), and the amount of elements
+         * under every root.
+         */
+        std::vector<std::size_t> parents;
+        std::vector<std::size_t> sizes;
+
+        /**
+         * @return The root of the tree of an element.
+         */
+        std::size_t findRoot(std::size_t element) const;
+
+        /**
+         * Merge the trees of two elements, the smaller under the bigger.
+         */
+        void unionRoots(std::size_t element1, std::size_t element2);
+
+    public:
+        /**
+         * Add a clan with no friends to the graph. If the clan is already
+         * in the graph, does nothing.
+         * @param clan The clan.
+         */
+        void add(Node clan);
+
+        /**
+         * @param clan A clan.
+         * @return true if the clan is in the graph, false otherwise.
+         */
+        bool contains(Node clan) const;
+
+        /**
+         * Make two clans friends, adding them to the graph if they aren't
+         * in it. If they already were friends, does nothing.
+         * @param clan1 One of the clans.
+         * @param clan2 The other clan.
+         */
+        void makeFriends(Node clan1, Node clan2);
+
+        /**
+         * Check if two clans are friends, in constant time.
+         * Every clan is a friend of itself.
+         * @param clan1 One of the clans.
+         * @param clan2 The other clan.
+         * @return true if the clans are friends, false otherwise.
+         */
+        bool areFriends(Node clan1, Node clan2) const;
+
+        /**
+         * Merge a clan into another one, in time linear in the amount of
+         * friends of the merged clan: its friends become friends of the other
+         * clan, and it is removed from the graph. If the two were friends,
+         * the friendship is removed.
+         * @param into The clan that stays, added to the graph if it isn't in
+         *  it.
+         * @param from The clan that is merged. If it is into, or isn't in the
+         *  graph, nothing changes.
+         */
+        void merge(Node into, Node from);
+
+        /**
+         * Check if two clans are allies, in time logarithmic in the amount
+         * of clans.
+         * @param clan1 One of the clans.
+         * @param clan2 The other clan.
+         * @return true if both clans are in the graph, and are connected by
+         *  a chain of friendships (or are the same clan), false otherwise.
+         */
+        bool areAllies(Node clan1, Node clan2) const;
+
+        /**
+         * @return Every alliance of the graph, as the clans in it (in no
+         *  particular order).
+         */
+        std::vector<std::vector<Node>> getAlliances() const;
+    };
+} // namespace mtm
+
+#endif //MTM4_FRIENDSHIP_GRAPH_H
@@ -1,48 +1,34 @@
 #include <iostream>
+#include <utility>
 #include "Group.h" /* includes string and ostream */
 #include "exceptions.h"
-
-/* Macros as default values */
-#define TOOLS_PER_ADULT 4
-#define FOOD_PER_ADULT 3
-#define FOOD_PER_CHILD 2
-#define MORALE_INITIAL 70
-
-/* Macros for morale limits */
-#define MORALE_MAX 100
-#define MORALE_MIN 0
-#define MORALE_MIN_FOR_UNITE 70
-
-/* Macros used for calculations of fight result */
-#define DIVISOR_FOOD 2
-#define DIVISOR_FOOD_FURTHER 2.0
-#define DIVISOR_CHILD_LOSER 3
-#define DIVISOR_ADULT_LOSER 3
-#define DIVISOR_TOOLS_LOSER 2
-#define DIVISOR_MORALE_LOSER 5
-#define DIVISOR_ADULT_WINNER 4.0
-#define DIVISOR_TOOLS_WINNER 4.0
-#define DIVISOR_MORALE_WINNER 5
+#include "GroupRules.h"
 
 namespace mtm {
 
-    int minOf3(int n1, int n2, int n3);
-    int ceil(int num, int denom);
+    /* The rules of everything but fight, trade and unite, which take a
+     * rule set */
+    typedef GroupEngine<DefaultGroupRules> Engine;
 
-    Group::Group(const std::string &name, const std::string &clan, int children,
+    Group::Group(std::string name, std::string clan, int children,
                  int adults, int tools, int food, int morale) {
         if (name.empty() || adults < 0 || children < 0 || tools < 0 || food < 0
-            || morale < MORALE_MIN || morale > MORALE_MAX) {
+            || !Engine::isValidMorale(morale)) {
             throw GroupInvalidArgs();
         }
         if (adults == 0 && children == 0) throw GroupInvalidArgs();
-        this->name = name;
-        this->clan = clan;
+        this->name = std::move(name);
+        this->clan = std::move(clan);
+        this->symbols = nullptr;
+        this->name_symbol = SymbolTable::EMPTY;
+        this->clan_symbol = SymbolTable::EMPTY;
+        this->listener = nullptr;
         this->children = children;
         this->adults = adults;
         this->tools = tools;
         this->food = food;
         this->morale = morale;
+        this->updatePower();
     }
 
     /**
@@ -59,24 +45,87 @@ namespace mtm {
      * @throws GroupInvalidArgs If at least one of the arguments is
      *  invalid, or both adults and children are 0.
      */
-    Group::Group(const std::string &name, int children, int adults) {
+    Group::Group(std::string name, int children, int adults) {
         if (name.empty() || children<0 || adults<0) throw GroupInvalidArgs();
         if (adults == 0 && children == 0)
             throw GroupInvalidArgs();
-        this->name = name;
+        this->name = std::move(name);
         this->children = children;
         this->adults = adults;
         this->clan = "";
-        this->tools = TOOLS_PER_ADULT * adults;
-        this->food = FOOD_PER_ADULT * adults + FOOD_PER_CHILD * children;
-        this->morale = MORALE_INITIAL;
+        this->symbols = nullptr;
+        this->name_symbol = SymbolTable::EMPTY;
+        this->clan_symbol = SymbolTable::EMPTY;
+        this->listener = nullptr;
+        this->tools = Engine::initialTools(adults);
+        this->food = Engine::initialFood(children, adults);
+        this->morale = Engine::initialMorale();
+        this->updatePower();
     }
 
     /**
      * Copy constructor
+     * The copy has no listener.
+     * @param other The group to copy
+     */
+    Group::Group(const Group &other)
+            : name(other.name), clan(other.clan), children(other.children),
+              adults(other.adults), tools(other.tools), food(other.food),
+              morale(other.morale), symbols(other.symbols),
+              name_symbol(other.name_symbol),
+              clan_symbol(other.clan_symbol), listener(nullptr),
+              power(other.power) {
+    }
+
+    /**
+     * Move constructor
+     * The new group has no listener.
+     * @param other The group to move
+     */
+    Group::Group(Group &&other)
+            : name(std::move(other.name)), clan(std::move(other.clan)),
+              children(other.children), adults(other.adults),
+              tools(other.tools), food(other.food), morale(other.morale),
+              symbols(other.symbols), name_symbol(other.name_symbol),
+              clan_symbol(other.clan_symbol), listener(nullptr),
+              power(other.power) {
+    }
+
+    /**
+     * Copy assignment operator
+     * This group keeps its listener.
      * @param other The group to copy
      */
-    Group::Group(const Group &other) = default;
+    Group &Group::operator=(const Group &other) {
+        if (this == &other) return *this;
+        return *this = Group(other);
+    }
+
+    /**
+     * Move assignment operator
+     * This group keeps its listener.
+     * @param other The group to move
+     */
+    Group &Group::operator=(Group &&other) {
+        if (this == &other) return *this;
+        std::string old_name;
+        if (this->listener) old_name = this->getName();
+        GroupTotals before = this->getTotals();
+        this->name = std::move(other.name);
+        this->clan = std::move(other.clan);
+        this->children = other.children;
+        this->adults = other.adults;
+        this->tools = other.tools;
+        this->food = other.food;
+        this->morale = other.morale;
+        this->symbols = other.symbols;
+        this->name_symbol = other.name_symbol;
+        this->clan_symbol = other.clan_symbol;
+        this->power = other.power;
+        this->renamed(old_name);
+        this->changed(before);
+        return *this;
+    }
 
     /** Destructor
      */
@@ -87,6 +136,7 @@ namespace mtm {
      * @return The name of the group
      */
     const std::string &Group::getName() const {
+        if (this->symbols) return this->symbols->name(this->name_symbol);
         return this->name;
     }
 
@@ -102,9 +152,93 @@ namespace mtm {
      * @return The name of the clan that the group belongs to.
      */
     const std::string &Group::getClan() const {
+        if (this->symbols) return this->symbols->name(this->clan_symbol);
         return this->clan;
     }
 
+    void Group::setName(const std::string &name) {
+        std::string old_name;
+        if (this->listener) old_name = this->getName();
+        if (this->symbols) {
+            this->name_symbol = this->symbols->intern(name);
+        } else {
+            this->name = name;
+        }
+        this->renamed(old_name);
+    }
+
+    void Group::renamed(const std::string &old_name) {
+        if (this->listener && this->getName() != old_name) {
+            this->listener->groupRenamed(*this, old_name);
+        }
+    }
+
+    /**
+     * @return The people, tools, food and power of the group.
+     */
+    GroupTotals Group::getTotals() const {
+        GroupTotals totals = {this->getSize(), this->tools, this->food,
+                              this->power};
+        return totals;
+    }
+
+    void Group::changed(const GroupTotals &before) {
+        if (!this->listener) return;
+        GroupTotals after = this->getTotals();
+        if (after.people != before.people || after.tools != before.tools
+            || after.food != before.food || after.power != before.power) {
+            this->listener->groupChanged(*this, before);
+        }
+    }
+
+    void Group::setClan(const std::string &clan) {
+        if (this->symbols) {
+            this->clan_symbol = this->symbols->intern(clan);
+        } else {
+            this->clan = clan;
+        }
+    }
+
+    /**
+     * Intern the name and clan of the group in a table. From now on,
+     *  every name and clan the group gets is interned in the table too,
+     *  and so are the names of the groups it divides into.
+     * The table must outlive the group.
+     * @param table The table.
+     */
+    void Group::intern(SymbolTable &table) {
+        if (this->symbols == &table) return;
+        SymbolTable::Symbol name_symbol = table.intern(this->getName());
+        SymbolTable::Symbol clan_symbol = table.intern(this->getClan());
+        this->symbols = &table;
+        this->name_symbol = name_symbol;
+        this->clan_symbol = clan_symbol;
+        this->name.clear();
+        this->clan.clear();
+    }
+
+    SymbolTable::Symbol Group::getNameSymbol() const {
+        if (this->symbols) return this->name_symbol;
+        return SymbolTable::NOT_FOUND;
+    }
+
+    const SymbolTable* Group::getSymbolTable() const {
+        return this->symbols;
+    }
+
+    /**
+     * Check if two groups belong to the same clan. If both groups are
+     *  interned in the same table, the clans are compared as symbols.
+     * @param other The group to compare with.
+     * @return true if the groups have the same clan, false otherwise.
+     */
+    bool Group::hasSameClan(const Group &other) const {
+        if (this->symbols && this->symbols == other.symbols) {
+            return this->clan_symbol == other.clan_symbol;
+        }
+        return this->getClan() == other.getClan();
+    }
+
     /**
      * Change the clan of the group.
      * If the group had a different clan before, reduce morale by 10%.
@@ -115,26 +249,58 @@ namespace mtm {
      * @param clan The name of the new clan that the groups will belong to.
      */
     void Group::changeClan(const std::string &clan) {
-        if (this->clan == clan) return;
-        if (!this->clan.empty()) {
-            this->morale = int(0.9 * double(this->morale));
+        GroupTotals before = this->getTotals();
+        this->moveToClan(clan, SymbolTable::NOT_FOUND);
+        this->changed(before);
+    }
+
+    void Group::moveToClan(const std::string &clan,
+                           SymbolTable::Symbol clan_symbol) {
+        if (this->symbols && clan_symbol != SymbolTable::NOT_FOUND) {
+            if (this->clan_symbol == clan_symbol) return;
+            this->morale = Engine::changeClanMorale(
+                    this->morale, this->clan_symbol != SymbolTable::EMPTY);
+            this->clan_symbol = clan_symbol;
         } else {
-            this->morale = int(1.1 * double(this->morale));
-            if (this->morale > 100) this->morale = 100;
+            if (this->getClan() == clan) return;
+            this->morale = Engine::changeClanMorale(this->morale,
+                                                    !this->getClan().empty());
+            this->setClan(clan);
         }
-        this->clan = clan;
+        this->updatePower();
     }
 
     /**
-     * Gets the power of the group.
+     * Recompute power from the fields.
      * Power is defined : (10nA + 3nC)*(10nT + nF)*morale/100
      * Where as: nA = number of adults, nC = number of children
      * nF = food, nT = tools
+     * The division by 100 is left out, so the value is an exact integer.
+     * Computed in 64 bits, so it doesn't overflow for any realistic group.
      */
-    double Group::getPower() const {
-        int sum = (10 * this->adults + 3 * this->children)
-                  * (10 * this->tools + this->food) * this->morale;
-        return sum / 100.0;
+    void Group::updatePower() {
+        this->power = Engine::power(this->children, this->adults,
+                                    this->tools, this->food, this->morale);
+    }
+
+    /**
+     * Compare two groups. according to power, and name.
+     * @param rhs
+     * @return A negative number if this group is smaller than rhs, 0 if
+     *  they have the same power and name, and a positive number if this
+     *  group is bigger.
+     */
+    int Group::compare(const Group &rhs) const {
+        if (this->power != rhs.power) return this->power < rhs.power ? -1 : 1;
+        return this->compareNames(rhs);
+    }
+
+    int Group::compareNames(const Group &rhs) const {
+        if (this->symbols && this->symbols == rhs.symbols
+            && this->name_symbol == rhs.name_symbol) {
+            return 0;
+        }
+        return this->getName().compare(rhs.getName());
     }
 
     /**
@@ -149,10 +315,7 @@ namespace mtm {
      *  false otherwise.
      */
     bool Group::operator<(const Group &rhs) const {
-        double power1 = this->getPower(), power2 = rhs.getPower();
-        if (power1 < power2) return true;
-        if (power1 > power2) return false;
-        return this->name < rhs.name;
+        return this->compare(rhs) < 0;
     }
 
     /**
@@ -163,7 +326,7 @@ namespace mtm {
      *  false otherwise.
      */
     bool Group::operator>(const Group &rhs) const {
-        return rhs < *this;
+        return this->compare(rhs) > 0;
     }
 
     /**
@@ -174,7 +337,7 @@ namespace mtm {
      *  false otherwise.
      */
     bool Group::operator<=(const Group &rhs) const {
-        return !(*this > rhs);
+        return this->compare(rhs) <= 0;
     }
 
     /**
@@ -185,7 +348,7 @@ namespace mtm {
      *  false otherwise.
      */
     bool Group::operator>=(const Group &rhs) const {
-        return !(*this < rhs);
+        return this->compare(rhs) >= 0;
     }
 
     /**
@@ -196,7 +359,7 @@ namespace mtm {
      * false otherwise.
      */
     bool Group::operator==(const Group &rhs) const {
-        return !(*this < rhs || *this > rhs);
+        return this->compare(rhs) == 0;
     }
 
     /**
@@ -207,49 +370,7 @@ namespace mtm {
      * false otherwise.
      */
     bool Group::operator!=(const Group &rhs) const {
-        return !(*this == rhs);
-    }
-
-    /**
-     * Try to unite two groups, this group, and given group.
-     * Will succeed only if the two groups are not the same group,
-     * belong to the same clan, both have at least 70 morale, and they
-     * don't surpass together a given amount of people.
-     * Should the union succeed, this group will change according to:
-     * - name = name of the more powerful group
-     * - clan = old clan
-     * - children = sum of the children in the two groups
-     * - adults = sum of the adults in the two groups
-     * - tools = sum of the tools in the two groups
-     * - food = sum of the food in the two groups
-     * - morale = average of the morales, counting the amount of people
-     * (floor)
-     *
-     * The other group will become empty.
-     * @param other The group to unite with.
-     * @param max_amount If the two groups have more people combined then
-     *  max_amount, then the union fails.
-     * @return True if Unite was successful, false otherwise.
-     */
-    bool Group::unite(Group &other, int max_amount) {
-        if (this == &other) return false;
-        int size_this = this->getSize();
-        int size_other = other.getSize();
-        if (this->clan != other.clan || (size_this + size_other) > max_amount
-            || this->morale < MORALE_MIN_FOR_UNITE
-            || other.morale < MORALE_MIN_FOR_UNITE) return false;
-        if (this->getPower() < other.getPower()) {
-            this->name = other.name;
-        }
-        this->adults += other.adults;
-        this->children += other.children;
-        this->food += other.food;
-        this->tools += other.tools;
-        int morale_total = this->morale * size_this + other.morale * size_other;
-        double morale_new = double(morale_total) / double(size_other+size_this);
-        this->morale = int(morale_new);
-        other.clearGroup();
-        return true;
+        return this->compare(rhs) != 0;
     }
 
     /**
@@ -271,189 +392,38 @@ namespace mtm {
      * @throws GroupCantDivide If the divided group Would be empty (can
      * only happen of this group has no more than 1 child and 1 adult).
      */
-    Group Group::divide(const std::string &name){
+    Group Group::divide(std::string name){
         if (name.empty()) throw GroupInvalidArgs();
         if(this->children <= 1 && this->adults <= 1){
             throw GroupCantDivide();
         }
-        Group new_group(name, clan, int(children / 2.0), int(adults / 2.0),
+        Group new_group(std::move(name), this->getClan(),
+                        int(children / 2.0), int(adults / 2.0),
                         int(tools / 2.0), int(food / 2.0), morale);
+        if (this->symbols) new_group.intern(*this->symbols);
+        GroupTotals before = this->getTotals();
         this->children = ceil(children, 2);
         this->adults = ceil(adults, 2);
         this->food = ceil(food, 2);
         this->tools = ceil(tools, 2);
+        this->updatePower();
+        this->changed(before);
         return new_group;
     }
 
-    /**
-     * This group fights an opponent group. The bigger group according to
-     *  the relational operators is the winner. If both groups are equal,
-     *  the groups will not fight.
-     *
-     * Fights effects on the loser group:
-     * - Losing third of each of the children and adult population (ceiling)
-     * - Losing Half of the tools, and half of the food (ceiling)
-     * - Morale decreases by 20%. (ceiling)
-     * For example: if a group that had 5 adults and 3 tools lost and 50
-     * morale, it will have 3 adults, 1 tool, and 40 morale after the fight.
-     *
-     * Fights effects on the winner group:
-     * - Losing a quarter of the adults (floor) and no children.
-     * - Losing a quarter of the tools (floor).
-     * - gaining half of the food the loser group lost in the fight. (floor)
-     *      The gain is equal to ceiling(loser.food / 2) / 2, even if the
-     *      loser group lost all of it's people.
-     * - Morale increases by 20%. (ceiling)
-     * @param opponent The group to fight with.
-     * @return WON if this group won, LOST if this group lost, and DRAW
-     * in case the 2 groups are equal.
-     * @throws GroupCantFightWithItself if opponent is the same as this
-     * @throws GroupCantFightEmptyGroup if this group, or the other group
-     *  is empty (i.e no people).
-     */
-    FIGHT_RESULT Group::fight(Group &opponent){
-        if (this == &opponent) throw GroupCantFightWithItself();
-        if ((this->getSize()==0) || (opponent.getSize() == 0)){
-            throw GroupCantFightEmptyGroup();
-        }
-        if (*this == opponent) {
-            return DRAW;
-        } else if (*this > opponent){ //This group wins
-            this->handleFight(opponent);
-            if(this->getPower()==0) this->clearGroup();
-            if(opponent.getPower()==0) opponent.clearGroup();
-            return WON;
-        } else {
-            opponent.handleFight(*this);
-            if(this->getPower()==0) this->clearGroup();
-            if(opponent.getPower()==0) opponent.clearGroup();
-            return LOST;
-        }
-    }
-
     /**
     * Clears fields in group.
     * all numbers become 0, all strings become empty.
     */
     void Group::clearGroup(){
-        this->name = "";
-        this->clan = "";
+        this->setName("");
+        this->setClan("");
         this->children = 0;
         this->adults = 0;
         this->tools = 0;
         this->food = 0;
         this->morale = 0;
-    }
-
-    /**
-     * handleFight: applies the aftermath of a fight.
-     * This Group is the winner, loser group in param
-     * Fights effects on the loser group:
-     * - Losing third of each of the children and adult population (ceiling)
-     * - Losing Half of the tools, and half of the food (ceiling)
-     * - Morale decreases by 20%. (ceiling)
-     * For example: if a group that had 5 adults and 3 tools lost and 50
-     * morale, it will have 3 adults, 1 tool, and 40 morale after the fight.
-     *
-     * Fights effects on the winner group:
-     * - Losing a quarter of the adults (floor) and no children.
-     * - Losing a quarter of the tools (floor).
-     * - gaining half of the food the loser group lost in the fight. (floor)
-     *      The gain is equal to ceiling(loser.food / 2) / 2, even if the
-     *      loser group lost all of it's people.
-     * - Morale increases by 20%. (ceiling)
-     * @param loser The losing Group
-     * This function assumes groups fought (can fight)
-     */
-    void Group::handleFight(Group &loser){
-        int lost_food = ceil(loser.food, DIVISOR_FOOD);
-        loser.children -= ceil(loser.children, DIVISOR_CHILD_LOSER);
-        loser.adults -= ceil(loser.adults, DIVISOR_ADULT_LOSER);
-        loser.tools -= ceil(loser.tools, DIVISOR_TOOLS_LOSER);
-        loser.food -= lost_food;
-        loser.morale -= ceil(loser.morale, DIVISOR_MORALE_LOSER);
-        this->adults -= int(this->adults/DIVISOR_ADULT_WINNER);
-        this->tools -= int(this->tools/DIVISOR_TOOLS_WINNER);
-        this->food += int(lost_food/DIVISOR_FOOD_FURTHER);
-        this->morale += ceil(this->morale, DIVISOR_MORALE_WINNER);
-        if (this->morale > 100) this->morale = 100;
-    }
-
-    int ceil(int num, int denom) {
-        return int((num + denom - 1) / double(denom));
-    }
-
-    /**
-     * Try to do a trade between the two groups.
-     * Each groups tries make its tools and food equal.
-     * To do that, each group offers |group's tools - group's food| / 2
-     * (ceiling) of the resource it has more of.
-     * If the other group offers the other resource, a trade is made.
-     * In the trade, each group gives the average of the offers [(offer1 +
-     * offer2)/2 (ceiling)], from the resource it has more of. A group
-     * can't give more tools or food than it has, and the two groups
-     * always trade the same amount of resources.
-     *
-     * If one of the groups has the same amount of tools as amount of
-     * food, or if both has more tools than food, or vice versa,
-     * the trade would not be made.
-     * @param other Group to trade with.
-     * @return true if a trade was made, false otherwise.
-     * @throws GroupCantTradeWithItself if other is the same as this
-     */
-    bool Group::trade(Group &other){
-        if (this == &other) throw GroupCantTradeWithItself();
-        int food1 = this->food, tools1 = this->tools;
-        int food2 = other.food, tools2 = other.tools;
-        if (food1 == tools1 || food2 == tools2 ||
-                (food1 > tools1 && food2 > tools2)||
-                (food1 < tools1 && food2 < tools2)) return false;
-        int trade_amount = this->checkTradeAmount(other);
-        if(food1>tools1){
-            this->food -= trade_amount;
-            other.food += trade_amount;
-            other.tools -= trade_amount;
-            this->tools += trade_amount;
-        }
-        else {
-            this->tools -= trade_amount;
-            other.tools += trade_amount;
-            other.food -= trade_amount;
-            this->food += trade_amount;
-        }
-        return true;
-    }
-
-    /**
-     * Checks how much trade should be done.
-     * Assumes trade has succeeded and calculates amount.
-     * @param other
-     * @return the amount that should be traded
-     */
-    int Group::checkTradeAmount(Group const &other) const{
-        int diff1 = this->food - this->tools;
-        int diff2 = other.food - other.tools;
-        bool moreFood = false;
-        if (diff1 < 0) { // this has more tools, other has more food.
-            diff1 = -diff1;
-        } else { // this has more food, other has more tools.
-            diff2 = -diff2;
-            moreFood = true;
-        }
-        diff1 = ceil(diff1, 2);
-        diff2 = ceil(diff2, 2);
-        int average = ceil(diff1 + diff2, 2);
-        if (moreFood) return minOf3(average, this->food, other.tools);
-        return minOf3(average, this->tools, other.food);
-    }
-
-    /**
-     * Returns smallest number among the given three.
-     */
-    int minOf3(int n1, int n2, int n3) {
-        if (n1 < n2 && n1 < n3) return n1;
-        if (n2 < n3) return n2;
-        return n3;
+        this->power = 0;
     }
 
     /**
@@ -471,8 +441,8 @@ namespace mtm {
      * @return the output stream
      */
     std::ostream& operator<<(std::ostream &os, const Group &group){
-        return os << "Group's name: " << group.name << std::endl
-         << "Group's clan: " << group.clan << std::endl
+        return os << "Group's name: " << group.getName() << std::endl
+         << "Group's clan: " << group.getClan() << std::endl
          << "Group's children: " << group.children << std::endl
          << "Group's adults: " << group.adults << std::endl
          << "Group's tools: " << group.tools << std::endl
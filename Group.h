@@ -1,9 +1,12 @@
 #ifndef MTM4_GROUP_HPP
 #define MTM4_GROUP_HPP
 
+#include <cstdint>
 #include <string>
 #include <ostream>
-
+#include "SymbolTable.h"
+#include "GroupRules.h"
+#include "exceptions.h"
 
 
 namespace mtm{
@@ -12,6 +15,43 @@ namespace mtm{
         WON, LOST, DRAW
     };
 
+    class Group;
+
+    /**
+     * The numbers of a group that can be summed up over many groups, like
+     *  the groups of a clan.
+     */
+    struct GroupTotals{
+        std::int64_t people, tools, food;
+        std::int64_t power; /* 100 times the power, exact */
+    };
+
+    /**
+     * Something that keeps track of groups, like the clan they belong to,
+     *  and is told when they change. A group has at most one listener.
+     */
+    class GroupListener{
+    public:
+        /**
+         * Called after the name of a group changed.
+         * @param group The group, with its new name.
+         * @param old_name The name of the group before the change.
+         */
+        virtual void groupRenamed(const Group& group,
+                                  const std::string& old_name) = 0;
+
+        /**
+         * Called after the numbers of a group changed.
+         * @param group The group, with its new numbers.
+         * @param before The totals of the group before the change.
+         */
+        virtual void groupChanged(const Group& group,
+                                  const GroupTotals& before) = 0;
+
+    protected:
+        ~GroupListener() = default;
+    };
+
     /**
     * A Family group of hunter-gatherers.
     */
@@ -20,20 +60,95 @@ namespace mtm{
         int children, adults, tools, food, morale;
 
         /**
-         * Gets the power of the group.
+         * The table that the name and the clan are interned in, or nullptr.
+         * When there is a table, the name and clan are kept only as
+         * symbols in it (and the strings above are empty), so they are
+         * compared as integers and never copied.
+         */
+        SymbolTable* symbols;
+        SymbolTable::Symbol name_symbol, clan_symbol;
+
+        /**
+         * The listener of the group (the clan it belongs to), or nullptr.
+         * Set by the listener itself, and not copied with the group.
+         */
+        GroupListener* listener;
+
+        /**
+         * Set the name or the clan, in the table if there is one.
+         */
+        void setName(const std::string& name);
+        void setClan(const std::string& clan);
+
+        /**
+         * The work of changeClan, without telling the listener (for a clan
+         * that moves many groups at once, and updates itself once).
+         * @param clan The name of the new clan.
+         * @param clan_symbol The symbol of clan in the table of the group,
+         *  or SymbolTable::NOT_FOUND to compare and set it as a string.
+         */
+        void moveToClan(const std::string& clan,
+                        SymbolTable::Symbol clan_symbol);
+
+        /**
+         * Tell the listener, if there is one, that the name changed.
+         * @param old_name The name before the change. Nothing is told if it
+         *  is the same as the current name.
+         */
+        void renamed(const std::string& old_name);
+
+        /**
+         * Tell the listener, if there is one, that the numbers changed.
+         * @param before The totals before the change. Nothing is told if
+         *  they are the same as the current totals.
+         */
+        void changed(const GroupTotals& before);
+
+        /**
+         * 100 times the power of the group, exact.
          * Power is defined : (10nA + 3nC)*(10nT + nF)*morale/100
          * Where as: nA = number of adults, nC = number of children
          * nF = food, nT = tools
+         * Kept up to date by updatePower(), so comparisons don't recompute it.
+         */
+        std::int64_t power;
+
+        /**
+         * Recompute power from the fields. Called after every change to
+         *  children, adults, tools, food or morale.
+         */
+        void updatePower();
+
+        /**
+         * @return 100 times the power of the group by a rule set. The cached
+         *  power is used if the rule set computes power like the default
+         *  rules.
          */
-        double getPower() const;
+        template<typename Rules>
+        std::int64_t rulesPower() const;
 
         /**
-         * handleFight: applies the aftermath of a fight.
+         * Compare two groups like compare(), by their power by a rule set.
+         */
+        template<typename Rules>
+        int compareBy(const Group& rhs) const;
+
+        /**
+         * Compare the names of two groups, as symbols if both are interned
+         *  in the same table.
+         * @return A negative number, 0 or a positive number, like
+         *  std::string::compare.
+         */
+        int compareNames(const Group& rhs) const;
+
+        /**
+         * handleFight: applies the aftermath of a fight, by a rule set.
          * This Group is the winner, loser group in param
          * @param loser The losing Group
          * This function assumes groups fought (can fight)
          */
-         void handleFight(Group &loser);
+        template<typename Rules>
+        void handleFight(Group &loser);
 
         /**
         * Clears fields in group. Only used when size = 0
@@ -41,14 +156,6 @@ namespace mtm{
         */
         void clearGroup();
 
-        /**
-     * Checks how much trade should be done.
-     * assumes trade has succeeded and calculates amount.
-     * @param other
-     * @return the amount that should be traded
-     */
-        int checkTradeAmount(Group const &other) const;
-
 
     public:
         /**
@@ -66,7 +173,7 @@ namespace mtm{
          * @throws `GroupInvalidArgs If at least one of the arguments is
          *  invalid, or both adults and children are 0.
          */
-        Group(const std::string& name, const std::string& clan, int children,
+        Group(std::string name, std::string clan, int children,
               int adults, int tools, int food, int morale);
 
         /**
@@ -83,14 +190,39 @@ namespace mtm{
          * @throws GroupInvalidArgs If at least one of the arguments is
          *  invalid, or both adults and children are 0.
          */
-        Group(const std::string& name, int children, int adults);
+        Group(std::string name, int children, int adults);
 
         /**
          * Copy constructor
+         * The copy has no listener.
          * @param other The group to copy
          */
         Group(const Group& other);
 
+        /**
+         * Move constructor
+         * Takes the strings of the other group instead of copying them.
+         * The new group has no listener.
+         * @param other The group to move. Its name and clan are left in a
+         *  valid but unspecified state.
+         */
+        Group(Group&& other);
+
+        /**
+         * Copy assignment operator
+         * This group keeps its listener.
+         * @param other The group to copy
+         */
+        Group& operator=(const Group& other);
+
+        /**
+         * Move assignment operator
+         * This group keeps its listener.
+         * @param other The group to move. Its name and clan are left in a
+         *  valid but unspecified state.
+         */
+        Group& operator=(Group&& other);
+
         /** Destructor
          */
         ~Group();
@@ -112,6 +244,40 @@ namespace mtm{
          */
         const std::string& getClan() const;
 
+        /**
+         * @return The people, tools, food and power of the group.
+         */
+        GroupTotals getTotals() const;
+
+        /**
+         * Intern the name and clan of the group in a table. From now on,
+         *  every name and clan the group gets is interned in the table too,
+         *  and so are the names of the groups it divides into.
+         * The table must outlive the group.
+         * @param table The table.
+         */
+        void intern(SymbolTable& table);
+
+        /**
+         * @return The symbol of the name of the group, in the table it is
+         *  interned in, or SymbolTable::NOT_FOUND if it isn't interned.
+         */
+        SymbolTable::Symbol getNameSymbol() const;
+
+        /**
+         * @return The table the group is interned in, or nullptr if it
+         *  isn't interned.
+         */
+        const SymbolTable* getSymbolTable() const;
+
+        /**
+         * Check if two groups belong to the same clan. If both groups are
+         *  interned in the same table, the clans are compared as symbols.
+         * @param other The group to compare with.
+         * @return true if the groups have the same clan, false otherwise.
+         */
+        bool hasSameClan(const Group& other) const;
+
         /**
          * Change the clan of the group.
          * If the group had a different clan before, reduce morale by 10%.
@@ -123,6 +289,16 @@ namespace mtm{
          */
         void changeClan(const std::string& clan);
 
+        /**
+         * Compare two groups. according to power, and name.
+         * All the relational operators are based on this comparison.
+         * @param rhs
+         * @return A negative number if this group is smaller than rhs (less
+         *  power, or same power and a smaller name), 0 if they have the same
+         *  power and name, and a positive number if this group is bigger.
+         */
+        int compare(const Group& rhs) const;
+
         /**
          * Compare two groups. according to power (defined here), and name.
          *
@@ -197,11 +373,18 @@ namespace mtm{
          * (floor)
          *
          * The other group will become empty.
+         * The more powerful group is the one with more power by the rule
+         *  set.
+         * The cached power that groups are compared, sorted and ranked by
+         *  always follows the default rules.
+         * @tparam Rules The rule set to play by, DefaultGroupRules by
+         *  default. Every rule set is compiled into its own code.
          * @param other The group to unite with.
          * @param max_amount If the two groups have more people combined then
          *  max_amount, then the union fails.
          * @return True if Unite was successful, false otherwise.
          */
+        template<typename Rules = DefaultGroupRules>
         bool unite(Group& other, int max_amount);
 
         /**
@@ -223,7 +406,7 @@ namespace mtm{
          * @throws GroupCantDivide If the divided group Would be empty (can
          * only happen of this group has no more than 1 child and 1 adult).
          */
-        Group divide(const std::string& name);
+        Group divide(std::string name);
 
         /**
          * This group fights an opponent group. The bigger group according to
@@ -244,6 +427,12 @@ namespace mtm{
          *      The gain is equal to ceiling(loser.food / 2) / 2, even if the
          *      loser group lost all of it's people.
          * - Morale increases by 20%. (ceiling)
+         * The bigger group, and the groups that are left with no power (and
+         *  become empty), are found by the power by the rule set.
+         * The cached power that groups are compared, sorted and ranked by
+         *  always follows the default rules.
+         * @tparam Rules The rule set to play by, DefaultGroupRules by
+         *  default. Every rule set is compiled into its own code.
          * @param opponent The group to fight with.
          * @return WON if this group won, LOST if this group lost, and DRAW
          * in case the 2 groups are equal.
@@ -251,6 +440,7 @@ namespace mtm{
          * @throws GroupCantFightEmptyGroup if this group, or the other group
          *  is empty (i.e no people).
          */
+        template<typename Rules = DefaultGroupRules>
         FIGHT_RESULT fight(Group& opponent);
 
         /**
@@ -267,10 +457,15 @@ namespace mtm{
          * If one of the groups has the same amount of tools as amount of
          * food, or if both has more tools than food, or vice versa,
          * the trade would not be made.
+         * The cached power that groups are compared, sorted and ranked by
+         *  always follows the default rules.
+         * @tparam Rules The rule set to play by, DefaultGroupRules by
+         *  default. Every rule set is compiled into its own code.
          * @param other Group to trade with.
          * @return true if a trade was made, false otherwise.
          * @throws GroupCantTradeWithItself if other is the same as this
          */
+        template<typename Rules = DefaultGroupRules>
         bool trade(Group& other);
 
 
@@ -289,7 +484,125 @@ namespace mtm{
          * @return the output stream
          */
         friend std::ostream& operator<<(std::ostream& os, const Group& group);
+
+        friend class PackedGroup;
+        friend class Clan;
     };
+
+    template<typename Rules>
+    std::int64_t Group::rulesPower() const {
+        if (GroupEngine<Rules>::hasDefaultPower()) return this->power;
+        return GroupEngine<Rules>::power(this->children, this->adults,
+                                         this->tools, this->food,
+                                         this->morale);
+    }
+
+    template<typename Rules>
+    int Group::compareBy(const Group &rhs) const {
+        std::int64_t power = this->rulesPower<Rules>();
+        std::int64_t rhs_power = rhs.rulesPower<Rules>();
+        if (power != rhs_power) return power < rhs_power ? -1 : 1;
+        return this->compareNames(rhs);
+    }
+
+    template<typename Rules>
+    bool Group::unite(Group &other, int max_amount) {
+        if (this == &other) return false;
+        int size_this = this->getSize();
+        int size_other = other.getSize();
+        if (!this->hasSameClan(other) || (size_this + size_other) > max_amount
+            || !GroupEngine<Rules>::canUnite(this->morale, other.morale)) {
+            return false;
+        }
+        GroupTotals this_before = this->getTotals();
+        GroupTotals other_before = other.getTotals();
+        if (this->rulesPower<Rules>() < other.rulesPower<Rules>()) {
+            if (this->symbols && this->symbols == other.symbols) {
+                /* The old name stays in the table */
+                const std::string& old_name = this->getName();
+                this->name_symbol = other.name_symbol;
+                this->renamed(old_name);
+            } else {
+                this->setName(other.getName());
+            }
+        }
+        this->adults += other.adults;
+        this->children += other.children;
+        this->food += other.food;
+        this->tools += other.tools;
+        int morale_total = this->morale * size_this + other.morale * size_other;
+        double morale_new = double(morale_total) / double(size_other+size_this);
+        this->morale = int(morale_new);
+        this->updatePower();
+        other.clearGroup();
+        this->changed(this_before);
+        other.changed(other_before);
+        return true;
+    }
+
+    template<typename Rules>
+    FIGHT_RESULT Group::fight(Group &opponent){
+        if (this == &opponent) throw GroupCantFightWithItself();
+        if ((this->getSize()==0) || (opponent.getSize() == 0)){
+            throw GroupCantFightEmptyGroup();
+        }
+        int order = this->compareBy<Rules>(opponent);
+        if (order == 0) return DRAW;
+        GroupTotals this_before = this->getTotals();
+        GroupTotals opponent_before = opponent.getTotals();
+        FIGHT_RESULT result;
+        if (order > 0){ //This group wins
+            this->handleFight<Rules>(opponent);
+            result = WON;
+        } else {
+            opponent.handleFight<Rules>(*this);
+            result = LOST;
+        }
+        if (this->rulesPower<Rules>() == 0) this->clearGroup();
+        if (opponent.rulesPower<Rules>() == 0) opponent.clearGroup();
+        this->changed(this_before);
+        opponent.changed(opponent_before);
+        return result;
+    }
+
+    template<typename Rules>
+    void Group::handleFight(Group &loser){
+        int lost_food = GroupEngine<Rules>::loseFight(loser.children,
+                                                      loser.adults,
+                                                      loser.tools, loser.food,
+                                                      loser.morale);
+        GroupEngine<Rules>::winFight(this->adults, this->tools, this->food,
+                                     this->morale, lost_food);
+        loser.updatePower();
+        this->updatePower();
+    }
+
+    template<typename Rules>
+    bool Group::trade(Group &other){
+        if (this == &other) throw GroupCantTradeWithItself();
+        int trade_amount = GroupEngine<Rules>::tradeAmount(
+                this->food, this->tools, other.food, other.tools);
+        if (trade_amount == 0) return false;
+        GroupTotals this_before = this->getTotals();
+        GroupTotals other_before = other.getTotals();
+        if (this->food > this->tools) {
+            this->food -= trade_amount;
+            other.food += trade_amount;
+            other.tools -= trade_amount;
+            this->tools += trade_amount;
+        }
+        else {
+            this->tools -= trade_amount;
+            other.tools += trade_amount;
+            other.food -= trade_amount;
+            this->food += trade_amount;
+        }
+        this->updatePower();
+        other.updatePower();
+        this->changed(this_before);
+        other.changed(other_before);
+        return true;
+    }
 } // namespace mtm
 
 #endif //MTM4_GROUP_HPP
@@ -0,0 +1,190 @@
+#ifndef MTM4_GROUP_RULES_H
+#define MTM4_GROUP_RULES_H
+
+#include <cstdint>
+
+namespace mtm{
+
+    /**
+     * Ceiling of num / denom, in integers. num is non-negative and denom is
+     *  positive.
+     */
+    inline int ceil(int num, int denom) {
+        return (num + denom - 1) / denom;
+    }
+
+    /**
+     * The rules of the game, as in the homework. These are the default
+     *  rules of Group, and the only rules of its constructors, its
+     *  changeClan and the power it caches.
+     * A rule set is a type with the same constants as this one (it can
+     *  derive from this one, and redefine only some of them). Group::fight,
+     *  Group::trade and Group::unite take a rule set as a template
+     *  argument. Every rule set is compiled into its own GroupEngine, so the
+     *  constants are folded into the code (and divisions by them become
+     *  multiplications) instead of being loaded on every fight.
+     */
+    struct DefaultGroupRules{
+        enum : int{
+            /* Default values of a new group, per person */
+            TOOLS_PER_ADULT = 4,
+            FOOD_PER_ADULT = 3,
+            FOOD_PER_CHILD = 2,
+            MORALE_INITIAL = 70,
+
+            /* Morale limits */
+            MORALE_MIN = 0,
+            MORALE_MAX = 100,
+            MORALE_MIN_FOR_UNITE = 70,
+
+            /* Morale after changing a clan, in percents of the morale
+             * before (floor): when leaving another clan, and when joining a
+             * clan without leaving one */
+            MORALE_PERCENT_LEAVE_CLAN = 90,
+            MORALE_PERCENT_JOIN_CLAN = 110,
+
+            /* Power: (ADULT_POWER * adults + CHILD_POWER * children) *
+             * (TOOLS_POWER * tools + FOOD_POWER * food) * morale / 100 */
+            ADULT_POWER = 10,
+            CHILD_POWER = 3,
+            TOOLS_POWER = 10,
+            FOOD_POWER = 1,
+
+            /* Fight: the loser loses 1 / DIVISOR of each (ceiling), and the
+             * winner loses 1 / DIVISOR of its adults and tools (floor),
+             * gains 1 / DIVISOR_FOOD_FURTHER of the food the loser lost
+             * (floor) and 1 / DIVISOR_MORALE_WINNER more morale (ceiling) */
+            DIVISOR_FOOD = 2,
+            DIVISOR_FOOD_FURTHER = 2,
+            DIVISOR_CHILD_LOSER = 3,
+            DIVISOR_ADULT_LOSER = 3,
+            DIVISOR_TOOLS_LOSER = 2,
+            DIVISOR_MORALE_LOSER = 5,
+            DIVISOR_ADULT_WINNER = 4,
+            DIVISOR_TOOLS_WINNER = 4,
+            DIVISOR_MORALE_WINNER = 5
+        };
+    };
+
+    /**
+     * The arithmetic of the rules of a rule set, on the numbers of groups.
+     *  All the numbers are non-negative.
+     * @tparam Rules The rule set, like DefaultGroupRules.
+     */
+    template<typename Rules = DefaultGroupRules>
+    struct GroupEngine{
+        /**
+         * @return 100 times the power of a group, exact.
+         */
+        static std::int64_t power(int children, int adults, int tools,
+                                  int food, int morale) {
+            return (std::int64_t(Rules::ADULT_POWER) * adults
+                    + std::int64_t(Rules::CHILD_POWER) * children)
+                   * (std::int64_t(Rules::TOOLS_POWER) * tools
+                      + std::int64_t(Rules::FOOD_POWER) * food)
+                   * morale;
+        }
+
+        /**
+         * @return true if the rule set computes power like the default
+         *  rules (the power that groups cache).
+         */
+        static constexpr bool hasDefaultPower() {
+            typedef DefaultGroupRules Default;
+            return int(Rules::ADULT_POWER) == int(Default::ADULT_POWER)
+                   && int(Rules::CHILD_POWER) == int(Default::CHILD_POWER)
+                   && int(Rules::TOOLS_POWER) == int(Default::TOOLS_POWER)
+                   && int(Rules::FOOD_POWER) == int(Default::FOOD_POWER);
+        }
+
+        static int initialTools(int adults) {
+            return Rules::TOOLS_PER_ADULT * adults;
+        }
+
+        static int initialFood(int children, int adults) {
+            return Rules::FOOD_PER_ADULT * adults
+                   + Rules::FOOD_PER_CHILD * children;
+        }
+
+        static int initialMorale() {
+            return Rules::MORALE_INITIAL;
+        }
+
+        static bool isValidMorale(int morale) {
+            return morale >= Rules::MORALE_MIN && morale <= Rules::MORALE_MAX;
+        }
+
+        /**
+         * @param morale The morale before changing the clan.
+         * @param had_clan Whether the group left another clan.
+         * @return The morale after changing the clan.
+         */
+        static int changeClanMorale(int morale, bool had_clan) {
+            if (had_clan) {
+                return morale * Rules::MORALE_PERCENT_LEAVE_CLAN / 100;
+            }
+            int joined = morale * Rules::MORALE_PERCENT_JOIN_CLAN / 100;
+            return joined < Rules::MORALE_MAX ? joined : Rules::MORALE_MAX;
+        }
+
+        static bool canUnite(int morale1, int morale2) {
+            return morale1 >= Rules::MORALE_MIN_FOR_UNITE
+                   && morale2 >= Rules::MORALE_MIN_FOR_UNITE;
+        }
+
+        /**
+         * The amount that two groups trade, by the rules of Group::trade:
+         *  each group offers half (ceiling) of the difference between the
+         *  resource it has more of and the other one, and they trade the
+         *  average of the offers (ceiling), but no more than either group
+         *  has of the resource it gives.
+         * @return The amount that each group gives, or 0 if they don't
+         *  trade (if one of them has as many tools as food, or both have
+         *  more of the same resource).
+         */
+        static int tradeAmount(int food1, int tools1, int food2, int tools2) {
+            if (food1 == tools1 || food2 == tools2
+                || (food1 > tools1) == (food2 > tools2)) {
+                return 0;
+            }
+            bool more_food = food1 > tools1;
+            int offer1 = ceil(more_food ? food1 - tools1 : tools1 - food1, 2);
+            int offer2 = ceil(more_food ? tools2 - food2 : food2 - tools2, 2);
+            int average = ceil(offer1 + offer2, 2);
+            int has1 = more_food ? food1 : tools1;
+            int has2 = more_food ? tools2 : food2;
+            int has = has1 < has2 ? has1 : has2;
+            return average < has ? average : has;
+        }
+
+        /**
+         * Apply the effects of a fight on the loser.
+         * @return The amount of food the loser lost.
+         */
+        static int loseFight(int& children, int& adults, int& tools,
+                             int& food, int& morale) {
+            int lost_food = ceil(food, Rules::DIVISOR_FOOD);
+            children -= ceil(children, Rules::DIVISOR_CHILD_LOSER);
+            adults -= ceil(adults, Rules::DIVISOR_ADULT_LOSER);
+            tools -= ceil(tools, Rules::DIVISOR_TOOLS_LOSER);
+            food -= lost_food;
+            morale -= ceil(morale, Rules::DIVISOR_MORALE_LOSER);
+            return lost_food;
+        }
+
+        /**
+         * Apply the effects of a fight on the winner.
+         * @param lost_food The amount of food the loser lost.
+         */
+        static void winFight(int& adults, int& tools, int& food, int& morale,
+                             int lost_food) {
+            adults -= adults / Rules::DIVISOR_ADULT_WINNER;
+            tools -= tools / Rules::DIVISOR_TOOLS_WINNER;
+            food += lost_food / Rules::DIVISOR_FOOD_FURTHER;
+            morale += ceil(morale, Rules::DIVISOR_MORALE_WINNER);
+            morale = morale < Rules::MORALE_MAX ? morale : Rules::MORALE_MAX;
+        }
+    };
+} // namespace mtm
+
+#endif //MTM4_GROUP_RULES_H
@@ -2,7 +2,41 @@
 
 namespace mtm {
 
-    Mountain::Mountain(const string &name) : Area(name), ruler("") {
+    Mountain::Mountain(const string &name) : Area(name), ruler(""),
+                                             ruler_symbols(nullptr),
+                                             ruler_symbol(SymbolTable::EMPTY) {
+    }
+
+    bool Mountain::hasRuler() const {
+        return this->ruler_symbols || !this->ruler.empty();
+    }
+
+    bool Mountain::isRuler(const Group &group) const {
+        if (this->ruler_symbols) {
+            return group.getSymbolTable() == this->ruler_symbols
+                   && group.getNameSymbol() == this->ruler_symbol;
+        }
+        return !this->ruler.empty() && group.getName() == this->ruler;
+    }
+
+    void Mountain::setRuler(const Group *group) {
+        /* A group that lost all of its people has no name to rule by */
+        if (group && group->getName().empty()) group = nullptr;
+        this->ruler_symbols = group ? group->getSymbolTable() : nullptr;
+        if (this->ruler_symbols) {
+            this->ruler_symbol = group->getNameSymbol();
+            this->ruler.clear();
+        } else {
+            this->ruler_symbol = SymbolTable::EMPTY;
+            this->ruler = group ? group->getName() : "";
+        }
+    }
+
+    GroupPointer Mountain::findRuler() const {
+        for (const GroupPointer& group : this->groups) {
+            if (this->isRuler(*group)) return group;
+        }
+        return nullptr;
     }
 
     // Deal with the option of a group becoming empty after a fight.
@@ -12,16 +46,18 @@ namespace mtm {
             Clan& group_clan = getNewGroupClan(group_name, clan, clan_map);
             const GroupPointer& group = group_clan.getGroup(group_name);
             this->groups.push_back(GroupPointer(group));
-            if (ruler.empty()){
-                ruler = group_name;
+            if (!this->hasRuler()){
+                this->setRuler(group.get());
                 return;
             }
-            const GroupPointer& group_ruler(this->findGroup(ruler));
-            if (group_ruler->getClan() == clan) {
-                if (*group_ruler < *group) ruler = group_name;
+            const GroupPointer group_ruler(this->findRuler());
+            if (group_ruler->hasSameClan(*group)) {
+                if (*group_ruler < *group) this->setRuler(group.get());
                 return;
             }
-            if (group->fight(*group_ruler) == WON) ruler = group_name;
+            if (group->fight(*group_ruler) == WON) {
+                this->setRuler(group.get());
+            }
             
         } catch(...) {
             throw;
@@ -32,18 +68,18 @@ namespace mtm {
         try{
             const GroupPointer group = this->findGroup(group_name);
             Area::groupLeave(group_name);
-            if (ruler != group_name) return;
+            if (!this->isRuler(*group)) return;
             if(this->groups.empty()){
-                this->ruler = "";
+                this->setRuler(nullptr);
                 return;
             }
             this->sortByStrongest();
             const GroupPointer& strongest = *this->groups.begin();
-            this->ruler = strongest->getName();
+            this->setRuler(strongest.get());
             for (const GroupPointer& current : this->groups){
                 if (current->getSize() == 0) continue;
-                if (current->getClan() == group->getClan()){
-                    this->ruler = current->getName();
+                if (current->hasSameClan(*group)){
+                    this->setRuler(current.get());
                     return;
                 }
             }
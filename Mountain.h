@@ -6,10 +6,41 @@
 #define MATAMUSH_MOUNTAIN_H
 
 #include "Area.h"
+#include "SymbolTable.h"
 
 namespace mtm {
     class Mountain : public Area {
+        /**
+         * The name of the group that rules the mountain, empty if there is
+         * none. The name of an interned group is kept only as its symbol in
+         * ruler_symbols (and ruler is empty), so the ruler is found by
+         * comparing integers, and its name is never copied.
+         */
         string ruler;
+        const SymbolTable* ruler_symbols;
+        SymbolTable::Symbol ruler_symbol;
+
+        /**
+         * @return true if a group rules the mountain.
+         */
+        bool hasRuler() const;
+
+        /**
+         * @param group A group in the mountain.
+         * @return true if the group rules the mountain.
+         */
+        bool isRuler(const Group& group) const;
+
+        /**
+         * Make a group the ruler of the mountain.
+         * @param group The new ruler, or nullptr for no ruler.
+         */
+        void setRuler(const Group* group);
+
+        /**
+         * @return The group that rules the mountain, or nullptr.
+         */
+        GroupPointer findRuler() const;
 
     public:
         explicit Mountain(const string& name);
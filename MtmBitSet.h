@@ -0,0 +1,398 @@
+#ifndef MTM4_BIT_SET_H
+#define MTM4_BIT_SET_H
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include "exceptions.h"
+#include "MtmSetIterator.h"
+
+namespace mtm{
+    /**
+     * Bit operations on a single 64-bit word.
+     */
+    namespace bits{
+        /**
+         * @return The amount of set bits in word.
+         */
+        inline int popcount(std::uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+            return __builtin_popcountll(word);
+#else
+            word = word - ((word >> 1) & 0x5555555555555555ULL);
+            word = (word & 0x3333333333333333ULL)
+                   + ((word >> 2) & 0x3333333333333333ULL);
+            word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+            return int((word * 0x0101010101010101ULL) >> 56);
+#endif
+        }
+
+        /**
+         * @return The index of the lowest set bit in word. word can't be 0.
+         */
+        inline int lowestBit(std::uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+            return __builtin_ctzll(word);
+#else
+            int index = 0;
+            while (!(word & 1)) {
+                word >>= 1;
+                ++index;
+            }
+            return index;
+#endif
+        }
+    } // namespace bits
+
+    /**
+     * A set of small non-negative integers, with the same interface as
+     * MtmSet, stored as a bitmap: element i is in the set if bit i is set.
+     * unite, intersect, isSuperSetOf and == work a whole word (64 elements)
+     * at a time, in plain loops over the words that the compiler can
+     * vectorize. size() counts bits with popcount.
+     * Iteration is in ascending order.
+     * @tparam Type An integral type.
+     * @tparam Domain The elements of the set are in the range [0, Domain).
+     */
+    template<typename Type, std::size_t Domain>
+    class MtmBitSet{
+        static_assert(std::is_integral<Type>::value,
+                      "MtmBitSet elements must be integers");
+        static_assert(Domain > 0, "MtmBitSet domain can't be empty");
+
+        static const std::size_t WORD_BITS = 64;
+        static const std::size_t WORD_COUNT =
+                (Domain + WORD_BITS - 1) / WORD_BITS;
+
+        std::uint64_t words[WORD_COUNT];
+
+        static bool inDomain(const Type& elem) {
+            return !(elem < Type(0)) && std::uint64_t(elem) < Domain;
+        }
+
+        static std::uint64_t bitOf(const Type& elem) {
+            return std::uint64_t(1) << (std::uint64_t(elem) % WORD_BITS);
+        }
+
+        static std::size_t wordOf(const Type& elem) {
+            return std::size_t(std::uint64_t(elem) / WORD_BITS);
+        }
+
+        /**
+         * Find the first element in the set, not smaller than a given
+         * position.
+         * @return The element, or Domain if there is no such element.
+         */
+        std::size_t nextFrom(std::size_t position) const {
+            if (position >= Domain) return Domain;
+            std::size_t word = position / WORD_BITS;
+            std::uint64_t remaining = words[word]
+                                      & (~std::uint64_t(0)
+                                         << (position % WORD_BITS));
+            while (!remaining) {
+                if (++word == WORD_COUNT) return Domain;
+                remaining = words[word];
+            }
+            return word * WORD_BITS + std::size_t(bits::lowestBit(remaining));
+        }
+
+    public:
+        /**
+         * The position of an iterator: an element in the set, or Domain at
+         * the end. The elements are bits, not objects, so get() returns
+         * the element by value, and the iterators are proxy iterators
+         * (see MtmSetIterator).
+         */
+        struct Cursor{
+            const MtmBitSet* set;
+            std::size_t position;
+
+            Cursor() : set(nullptr), position(Domain) {
+            }
+
+            Cursor(const MtmBitSet* set, std::size_t position)
+                    : set(set), position(position) {
+            }
+
+            bool isEnd() const {
+                return !set || position >= Domain;
+            }
+
+            Type get() const {
+                return Type(position);
+            }
+
+            void next() {
+                position = set->nextFrom(position + 1);
+            }
+
+            bool operator==(const Cursor& rhs) const {
+                return set == rhs.set && position == rhs.position;
+            }
+        };
+
+        typedef MtmSetIterator<Type, Cursor, false> iterator;
+        typedef MtmSetIterator<Type, Cursor, true> const_iterator;
+
+        /**
+         * Empty constructor
+         * Creates an empty set
+         */
+        MtmBitSet() {
+            clear();
+        }
+
+        /**
+         * Insert a new element to the set. Does nothing if it's already in
+         *  the set. Iterators stay valid.
+         * @param elem The element to insert to the set
+         * @return An iterator to the element.
+         * @throws MTMSetElementOutOfDomain if elem isn't in [0, Domain).
+         */
+        iterator insert(const Type& elem){
+            if (!inDomain(elem)) throw MTMSetElementOutOfDomain();
+            words[wordOf(elem)] |= bitOf(elem);
+            return iterator(Cursor(this, std::size_t(elem)));
+        }
+
+        /**
+         * Remove an element from the set. If the element isn't in the set,
+         *  does nothing.
+         * @param elem the element to remove.
+         */
+        void erase(const Type& elem){
+            if (!inDomain(elem)) return;
+            words[wordOf(elem)] &= ~bitOf(elem);
+        }
+
+        /**
+         * Remove the element the iterator points to from the set.
+         * @param it The iterator to the element to the set.
+         */
+        void erase(const iterator& it){
+            erase(*it);
+        }
+
+        /**
+         * Get the amount of elements in the set.
+         * @return The amount of elements in the set.
+         */
+        int size() const{
+            int total = 0;
+            for (std::size_t i = 0; i < WORD_COUNT; ++i) {
+                total += bits::popcount(words[i]);
+            }
+            return total;
+        }
+
+        /**
+         * Check if the set is empty.
+         * @return true is the set is empty.
+         */
+        bool empty() const{
+            std::uint64_t any = 0;
+            for (std::size_t i = 0; i < WORD_COUNT; ++i) any |= words[i];
+            return any == 0;
+        }
+
+        /**
+         * Empty the set.
+         */
+        void clear(){
+            for (std::size_t i = 0; i < WORD_COUNT; ++i) words[i] = 0;
+        }
+
+        /**
+         * Get an iterator to the smallest element in the set.
+         * If set is empty, return the same as end.
+         */
+        iterator begin(){
+            return iterator(Cursor(this, nextFrom(0)));
+        }
+
+        /**
+         * Get a const_iterator to the smallest element in the set.
+         * If set is empty, return the same as end.
+         */
+        const_iterator begin() const{
+            return const_iterator(Cursor(this, nextFrom(0)));
+        }
+
+        /**
+         * Returns an iterator referring to the past-the-end element in the set.
+         * @return Iterator to past-the-end element.
+         */
+        iterator end(){
+            return iterator();
+        }
+
+        /**
+         * Returns a const_iterator referring to the past-the-end element in
+         * the set.
+         * @return const_iterator to past-the-end element.
+         */
+        const_iterator end() const{
+            return const_iterator();
+        }
+
+        /**
+         * Find an element in the set.
+         * @param elem The element to find
+         * @return An iterator that points to the elem, or end() if the
+         *  element isn't in the set.
+         */
+        iterator find(const Type& elem){
+            if (!contains(elem)) return end();
+            return iterator(Cursor(this, std::size_t(elem)));
+        }
+
+        /**
+         * Find an element in the set.
+         * @param elem The element to find
+         * @return A const_iterator that points to the elem, or end() if the
+         *  element isn't in the set.
+         */
+        const_iterator find(const Type& elem) const{
+            if (!contains(elem)) return end();
+            return const_iterator(Cursor(this, std::size_t(elem)));
+        }
+
+        /**
+         * Check if an element is in the set.
+         * @param elem The element to check if it's in the set.
+         * @return True if the element is in the set, false otherwise.
+         */
+        bool contains(const Type& elem) const{
+            return inDomain(elem) && (words[wordOf(elem)] & bitOf(elem));
+        }
+
+        /**
+         * Check if this set is a superset of a given set.
+         * @param subset The set to check if it's a subset.
+         * @return True if the given set is a subset of this set.
+         */
+        bool isSuperSetOf(const MtmBitSet& subset) const{
+            std::uint64_t missing = 0;
+            for (std::size_t i = 0; i < WORD_COUNT; ++i) {
+                missing |= subset.words[i] & ~words[i];
+            }
+            return missing == 0;
+        }
+
+        /**
+         * Check if two set are equal, meaning, they contain the same elements.
+         * @param rhs The set right of the == operator.
+         * @return true if the two set contain the same elements, false
+         *  otherwise.
+         */
+        bool operator==(const MtmBitSet& rhs) const{
+            std::uint64_t different = 0;
+            for (std::size_t i = 0; i < WORD_COUNT; ++i) {
+                different |= words[i] ^ rhs.words[i];
+            }
+            return different == 0;
+        }
+
+        /**
+         * Check if two set are equal, meaning, they contain the same elements.
+         * @param rhs The set right of the != operator.
+         * @return false if the two set contain the same elements, true
+         *  otherwise.
+         */
+        bool operator!=(const MtmBitSet& rhs) const{
+            return !(*this == rhs);
+        }
+
+        /**
+         * Insert all the elements in the given set to this set (union).
+         * @param set The set to insert all the elements from.
+         * @return A reference to this set.
+         */
+        MtmBitSet& unite(const MtmBitSet& set){
+            for (std::size_t i = 0; i < WORD_COUNT; ++i) {
+                words[i] |= set.words[i];
+            }
+            return *this;
+        }
+
+        /**
+         * Returns a new set that is an union of this set, and a given set.
+         * @param set The other set (other than this) to be in the union.
+         * @return The new set.
+         */
+        MtmBitSet unite(const MtmBitSet& set) const{
+            MtmBitSet united(*this);
+            united.unite(set);
+            return united;
+        }
+
+        /**
+         * Remove all the elements from this set, that are not in the given set
+         * (intersection).
+         * @param set The other set in the intersection.
+         * @return A reference to this set.
+         */
+        MtmBitSet& intersect(const MtmBitSet& set){
+            for (std::size_t i = 0; i < WORD_COUNT; ++i) {
+                words[i] &= set.words[i];
+            }
+            return *this;
+        }
+
+        /**
+         * Returns a new set that is an intersection of this set,
+         *  and a given set.
+         * @param set The other set (other than this) to be in the intersection.
+         * @return The new set.
+         */
+        MtmBitSet intersect(const MtmBitSet& set) const{
+            MtmBitSet intersected(*this);
+            intersected.intersect(set);
+            return intersected;
+        }
+
+        /**
+         * Remove all the elements in the set, that doesn't meet a given
+         *  condition.
+         * @tparam func - A function of an object-function that receive 1
+         *  argument, of the same type as an element in the set, and returns
+         *  a bool.
+         * @param condition - function (or object-function) that returns true
+         * if the element is meeting the condition and false otherwise.
+         * @return A reference to this set.
+         */
+        template<typename func>
+        MtmBitSet& getSubSet(func condition){
+            for (std::size_t i = 0; i < WORD_COUNT; ++i) {
+                std::uint64_t remaining = words[i];
+                while (remaining) {
+                    int bit = bits::lowestBit(remaining);
+                    remaining &= remaining - 1;
+                    if (!condition(Type(i * WORD_BITS + std::size_t(bit)))) {
+                        words[i] &= ~(std::uint64_t(1) << bit);
+                    }
+                }
+            }
+            return *this;
+        }
+
+        /**
+         * Get a subset of this set, that contains all the elements in the set,
+         * that meet a given condition.
+         * @tparam func - A function of an object-function that receive 1
+         *  argument, of the same type as an element in the set, and returns
+         *  a bool.
+         * @param condition - function (or object-function) that returns true
+         * if the element is meeting the condition and false otherwise.
+         * @return A the new set.
+         */
+        template<typename func>
+        MtmBitSet getSubSet(func condition) const{
+            MtmBitSet subset(*this);
+            subset.getSubSet(condition);
+            return subset;
+        }
+    };
+} // namespace mtm
+
+#endif //MTM4_BIT_SET_H
@@ -0,0 +1,179 @@
+#ifndef MTM4_CONCURRENT_SET_H
+#define MTM4_CONCURRENT_SET_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include "MtmHashSet.h"
+
+namespace mtm{
+    /**
+     * A set that can be used by several threads at once.
+     * The elements are split between StripeCount stripes by their hash, and
+     * each stripe is an MtmHashSet with its own lock. Operations on elements
+     * of different stripes don't block each other.
+     * There are no iterators, since they could point to an element another
+     * thread is erasing. Iteration is done under the locks, by forEach(),
+     * or on a copy, by snapshot().
+     * @tparam Type The type of an element on the set.
+     *      Required to implement:
+     *                             - operator ==
+     *                             - copy constructor
+     * @tparam Hash A function-object that receives an element and returns
+     *  its hash (std::size_t). Equal elements must have equal hashes.
+     * @tparam StripeCount The amount of stripes (and locks).
+     */
+    template<typename Type, typename Hash = std::hash<Type>,
+            std::size_t StripeCount = 16>
+    class MtmConcurrentSet{
+        /**
+         * Size of a cache line. Every stripe starts on a cache line of its
+         * own (and its size is rounded up to whole lines), so threads that
+         * lock different stripes don't write to the same cache line.
+         * This holds for sets with static or automatic storage, and for
+         * members of them. In C++11, new (and so std::vector, make_shared,
+         * etc.) doesn't have to honor an alignment bigger than that of
+         * std::max_align_t, so a set that is allocated on the heap may have
+         * stripes that share cache lines (it is still correct, only
+         * slower).
+         */
+        static const std::size_t CACHE_LINE = 64;
+
+        struct alignas(CACHE_LINE) Stripe{
+            mutable std::mutex lock;
+            MtmHashSet<Type, Hash> set;
+        };
+
+        Stripe stripes[StripeCount];
+        Hash hasher;
+
+        /**
+         * Choose the stripe of an element. The hash is mixed first: the
+         * stripe's own table indexes by the low bits of the hash, so they
+         * shouldn't also decide the stripe.
+         */
+        std::size_t stripeIndex(const Type& elem) const {
+            std::uint64_t mixed = std::uint64_t(hasher(elem))
+                                  * 0x9E3779B97F4A7C15ULL;
+            return std::size_t((mixed >> 32) % StripeCount);
+        }
+
+    public:
+        /**
+         * Empty constructor
+         * Creates an empty set
+         */
+        MtmConcurrentSet() = default;
+
+        /**
+         * Disable copy constructor and assignment operator. Use snapshot()
+         * to copy the elements.
+         */
+        MtmConcurrentSet(const MtmConcurrentSet&) = delete;
+        MtmConcurrentSet &operator=(const MtmConcurrentSet&) = delete;
+
+        /**
+         * Insert a new element to the set, doesn't insert if there is already
+         *  an equal element in the set.
+         * @param elem The element to insert to the set
+         * @return true if the element was inserted, false if an equal
+         *  element was already in the set.
+         */
+        bool insert(const Type& elem){
+            Stripe& stripe = stripes[stripeIndex(elem)];
+            std::lock_guard<std::mutex> guard(stripe.lock);
+            int size_before = stripe.set.size();
+            stripe.set.insert(elem);
+            return stripe.set.size() != size_before;
+        }
+
+        /**
+         * Remove an element from the set. If there is no element equal to
+         *  elem in the set, does nothing.
+         * @param elem the element to remove.
+         * @return true if an element was removed, false otherwise.
+         */
+        bool erase(const Type& elem){
+            Stripe& stripe = stripes[stripeIndex(elem)];
+            std::lock_guard<std::mutex> guard(stripe.lock);
+            int size_before = stripe.set.size();
+            stripe.set.erase(elem);
+            return stripe.set.size() != size_before;
+        }
+
+        /**
+         * Check if an element is in the set.
+         * @param elem The element to check if it's in the set.
+         * @return True if the element is in the set, false otherwise.
+         */
+        bool contains(const Type& elem) const{
+            const Stripe& stripe = stripes[stripeIndex(elem)];
+            std::lock_guard<std::mutex> guard(stripe.lock);
+            return stripe.set.contains(elem);
+        }
+
+        /**
+         * Get the amount of elements in the set.
+         * While other threads change the set, this is the sum of the stripes'
+         * sizes, each at the moment it was counted.
+         * @return The amount of elements in the set.
+         */
+        int size() const{
+            int total = 0;
+            for (const Stripe& stripe : stripes) {
+                std::lock_guard<std::mutex> guard(stripe.lock);
+                total += stripe.set.size();
+            }
+            return total;
+        }
+
+        /**
+         * Check if the set is empty.
+         * @return true is the set is empty.
+         */
+        bool empty() const{
+            return size() == 0;
+        }
+
+        /**
+         * Empty the set, free all allocated memory in the set.
+         */
+        void clear(){
+            for (Stripe& stripe : stripes) {
+                std::lock_guard<std::mutex> guard(stripe.lock);
+                stripe.set.clear();
+            }
+        }
+
+        /**
+         * Call a function on every element in the set, one stripe at a time.
+         * Elements in a stripe can't change while the function is called on
+         * them, but elements in other stripes can.
+         * @tparam func - A function or an object-function that receives 1
+         *  argument, of the same type as an element in the set. Must not use
+         *  this set (the stripe's lock is held).
+         * @param action - The function to call.
+         */
+        template<typename func>
+        void forEach(func action) const{
+            for (const Stripe& stripe : stripes) {
+                std::lock_guard<std::mutex> guard(stripe.lock);
+                for (const Type& elem : stripe.set) action(elem);
+            }
+        }
+
+        /**
+         * Get a copy of all the elements in the set, that can be iterated
+         * without any lock.
+         * @return A new set with the elements of this set.
+         */
+        MtmHashSet<Type, Hash> snapshot() const{
+            MtmHashSet<Type, Hash> copied;
+            forEach([&copied](const Type& elem) { copied.insert(elem); });
+            return copied;
+        }
+    };
+} // namespace mtm
+
+#endif //MTM4_CONCURRENT_SET_H
@@ -0,0 +1,412 @@
+#ifndef MTM4_FLAT_SET_H
+#define MTM4_FLAT_SET_H
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <vector>
+#include "exceptions.h"
+#include "MtmSetIterator.h"
+
+namespace mtm{
+    /**
+     * A set with the same interface as MtmSet, that keeps its elements
+     * sorted in one contiguous array.
+     * find and contains are binary searches, and unite, intersect and
+     * isSuperSetOf are linear merges of the two arrays. insert and erase
+     * shift the elements after the changed position, so the set suits
+     * contents that are read far more often than they are written.
+     * Iteration is in ascending order.
+     * @tparam Type The type of an element on the set.
+     *      Required to implement:
+     *                             - copy constructor
+     *                             - copy assignment operator
+     * @tparam Compare A function-object that receives two elements and
+     *  returns true if the first is smaller. Two elements are equal if
+     *  neither is smaller than the other.
+     */
+    template<typename Type, typename Compare = std::less<Type> >
+    class MtmFlatSet{
+        /**
+         * Properties of class MtmFlatSet
+         * elements - The elements of the set, sorted by compare, no two
+         *  of them equal.
+         */
+        std::vector<Type> elements;
+        Compare compare;
+
+        bool equal(const Type& first, const Type& second) const {
+            return !compare(first, second) && !compare(second, first);
+        }
+
+        /**
+         * Find the position of the first element that is not smaller than
+         * elem.
+         */
+        std::size_t lowerBound(const Type& elem) const {
+            return std::size_t(std::lower_bound(elements.begin(),
+                                                elements.end(), elem, compare)
+                               - elements.begin());
+        }
+
+        /**
+         * Find the position of an element equal to elem.
+         * @return The position, or elements.size() if there is no such
+         *  element.
+         */
+        std::size_t position(const Type& elem) const {
+            std::size_t found = lowerBound(elem);
+            if (found < elements.size() && !compare(elem, elements[found])) {
+                return found;
+            }
+            return elements.size();
+        }
+
+        /**
+         * Sort the elements, and remove the duplicates.
+         */
+        void normalize() {
+            std::sort(elements.begin(), elements.end(), compare);
+            typename std::vector<Type>::iterator last =
+                    std::unique(elements.begin(), elements.end(),
+                                [this](const Type& first, const Type& second) {
+                                    return this->equal(first, second);
+                                });
+            elements.erase(last, elements.end());
+        }
+
+    public:
+        /**
+         * The position of an iterator: an index in elements.
+         */
+        struct Cursor{
+            const std::vector<Type>* elements;
+            std::size_t position;
+
+            Cursor() : elements(nullptr), position(0) {
+            }
+
+            Cursor(const std::vector<Type>* elements, std::size_t position)
+                    : elements(elements), position(position) {
+            }
+
+            bool isEnd() const {
+                return !elements || position >= elements->size();
+            }
+
+            const Type& get() const {
+                return (*elements)[position];
+            }
+
+            void next() {
+                ++position;
+            }
+
+            bool operator==(const Cursor& rhs) const {
+                return elements == rhs.elements && position == rhs.position;
+            }
+        };
+
+        typedef MtmSetIterator<Type, Cursor, false> iterator;
+        typedef MtmSetIterator<Type, Cursor, true> const_iterator;
+
+        /**
+         * Empty constructor
+         * Creates an empty set
+         */
+        MtmFlatSet() = default;
+
+        /**
+         * Creates an empty set, that orders its elements with a given
+         *  comparator (for comparators that have a state).
+         * @param compare The comparator. Sets made from this set (by the
+         *  const unite, intersect and getSubSet) use it too.
+         */
+        explicit MtmFlatSet(const Compare& compare) : compare(compare) {
+        }
+
+        /**
+         * Bulk constructor. Creates a set of all the elements in a range,
+         * sorting and removing duplicates once, after all of them were read.
+         * @tparam InputIterator An iterator that supports ++, * and !=
+         *  (e.g. an iterator of MtmSet).
+         * @param first An iterator to the first element in the range.
+         * @param last An iterator past the last element in the range.
+         * @param compare The comparator of the set.
+         */
+        template<typename InputIterator>
+        MtmFlatSet(InputIterator first, InputIterator last,
+                   const Compare& compare = Compare()) : compare(compare) {
+            for ( ; first != last; ++first) elements.push_back(*first);
+            normalize();
+        }
+
+        /**
+         * Insert a new element to the set, doesn't insert if there is already
+         *  an equal element in the set.
+         * If an element was't inserted, all iterators should stay valid.
+         * @param elem The element to insert to the set
+         * @return An iterator to the inserted element, or to the equal
+         * element if the element wasn't inserted.
+         */
+        iterator insert(const Type& elem){
+            std::size_t found = lowerBound(elem);
+            if (found == elements.size() || compare(elem, elements[found])) {
+                elements.insert(elements.begin() + found, elem);
+            }
+            return iterator(Cursor(&elements, found));
+        }
+
+        /**
+         * Remove an element from the set. If there is no element equal to
+         *  elem in the set, does nothing.
+         * If an element wasn't removed, all iterators should stay valid.
+         * @param elem the element to remove.
+         */
+        void erase(const Type& elem){
+            std::size_t found = position(elem);
+            if (found == elements.size()) return;
+            elements.erase(elements.begin() + found);
+        }
+
+        /**
+         * Remove the element the iterator points to from the set.
+         * Iterator to another set is undefined.
+         * @param it The iterator to the element to the set.
+         */
+        void erase(const iterator& it){
+            if (it.cursor().isEnd()) throw NodeIsEndException();
+            elements.erase(elements.begin() + it.cursor().position);
+        }
+
+        /**
+         * Get the amount of elements in the set.
+         * @return The amount of elements in the set.
+         */
+        int size() const{
+            return int(elements.size());
+        }
+
+        /**
+         * Check if the set is empty.
+         * @return true is the set is empty.
+         */
+        bool empty() const{
+            return elements.empty();
+        }
+
+        /**
+         * Empty the set, free all allocated memory in the set.
+         */
+        void clear(){
+            std::vector<Type>().swap(elements);
+        }
+
+        /**
+         * Get an iterator to the smallest element in the set.
+         * If set is empty, return the same as end.
+         */
+        iterator begin(){
+            return iterator(Cursor(&elements, 0));
+        }
+
+        /**
+         * Get a const_iterator to the smallest element in the set.
+         * If set is empty, return the same as end.
+         */
+        const_iterator begin() const{
+            return const_iterator(Cursor(&elements, 0));
+        }
+
+        /**
+         * Returns an iterator referring to the past-the-end element in the set.
+         * @return Iterator to past-the-end element.
+         */
+        iterator end(){
+            return iterator();
+        }
+
+        /**
+         * Returns a const_iterator referring to the past-the-end element in
+         * the set.
+         * @return const_iterator to past-the-end element.
+         */
+        const_iterator end() const{
+            return const_iterator();
+        }
+
+        /**
+         * Find an element in the set.
+         * @param elem The element to find
+         * @return An iterator that points to the elem, or end() if the
+         *  element isn't in the set.
+         */
+        iterator find(const Type& elem){
+            std::size_t found = position(elem);
+            if (found == elements.size()) return end();
+            return iterator(Cursor(&elements, found));
+        }
+
+        /**
+         * Find an element in the set.
+         * @param elem The element to find
+         * @return A const_iterator that points to the elem, or end() if the
+         *  element isn't in the set.
+         */
+        const_iterator find(const Type& elem) const{
+            std::size_t found = position(elem);
+            if (found == elements.size()) return end();
+            return const_iterator(Cursor(&elements, found));
+        }
+
+        /**
+         * Check if an element is in the set.
+         * @param elem The element to check if it's in the set.
+         * @return True if the element is in the set, false otherwise.
+         */
+        bool contains(const Type& elem) const{
+            return position(elem) != elements.size();
+        }
+
+        /**
+         * Check if this set is a superset of a given set.
+         * A single merge of the two sorted arrays.
+         * @param subset The set to check if it's a subset.
+         * @return True if the given set is a subset of this set.
+         */
+        bool isSuperSetOf(const MtmFlatSet& subset) const{
+            return std::includes(elements.begin(), elements.end(),
+                                 subset.elements.begin(),
+                                 subset.elements.end(), compare);
+        }
+
+        /**
+         * Check if two set are equal, meaning, they contain the same elements.
+         * @param rhs The set right of the == operator.
+         * @return true if the two set contain the same elements, false
+         *  otherwise.
+         */
+        bool operator==(const MtmFlatSet& rhs) const{
+            if (this->elements.size() != rhs.elements.size()) return false;
+            for (std::size_t i = 0; i < elements.size(); ++i) {
+                if (!equal(this->elements[i], rhs.elements[i])) return false;
+            }
+            return true;
+        }
+
+        /**
+         * Check if two set are equal, meaning, they contain the same elements.
+         * @param rhs The set right of the != operator.
+         * @return false if the two set contain the same elements, true
+         *  otherwise.
+         */
+        bool operator!=(const MtmFlatSet& rhs) const{
+            return !(*this == rhs);
+        }
+
+        /**
+         * Insert all the elements in the given set to this set (union).
+         * A single merge of the two sorted arrays.
+         * @param set The set to insert all the elements from.
+         * @return A reference to this set.
+         */
+        MtmFlatSet& unite(const MtmFlatSet& set){
+            if (this == &set || set.empty()) return *this;
+            std::vector<Type> united;
+            united.reserve(elements.size() + set.elements.size());
+            std::set_union(elements.begin(), elements.end(),
+                           set.elements.begin(), set.elements.end(),
+                           std::back_inserter(united), compare);
+            elements.swap(united);
+            return *this;
+        }
+
+        /**
+         * Returns a new set that is an union of this set, and a given set.
+         * @param set The other set (other than this) to be in the union.
+         * @return The new set.
+         */
+        MtmFlatSet unite(const MtmFlatSet& set) const{
+            MtmFlatSet united(compare);
+            united.elements.reserve(elements.size() + set.elements.size());
+            std::set_union(elements.begin(), elements.end(),
+                           set.elements.begin(), set.elements.end(),
+                           std::back_inserter(united.elements), compare);
+            return united;
+        }
+
+        /**
+         * Remove all the elements from this set, that are not in the given set
+         * (intersection).
+         * A single merge of the two sorted arrays.
+         * @param set The other set in the intersection.
+         * @return A reference to this set.
+         */
+        MtmFlatSet& intersect(const MtmFlatSet& set){
+            if (this == &set) return *this;
+            MtmFlatSet intersected =
+                    static_cast<const MtmFlatSet&>(*this).intersect(set);
+            elements.swap(intersected.elements);
+            return *this;
+        }
+
+        /**
+         * Returns a new set that is an intersection of this set,
+         *  and a given set.
+         * @param set The other set (other than this) to be in the intersection.
+         * @return The new set.
+         */
+        MtmFlatSet intersect(const MtmFlatSet& set) const{
+            MtmFlatSet intersected(compare);
+            intersected.elements.reserve(std::min(elements.size(),
+                                                  set.elements.size()));
+            std::set_intersection(elements.begin(), elements.end(),
+                                  set.elements.begin(), set.elements.end(),
+                                  std::back_inserter(intersected.elements),
+                                  compare);
+            return intersected;
+        }
+
+        /**
+         * Remove all the elements in the set, that doesn't meet a given
+         *  condition.
+         * @tparam func - A function of an object-function that receive 1
+         *  argument, of the same type as an element in the set, and returns
+         *  a bool.
+         * @param condition - function (or object-function) that returns true
+         * if the element is meeting the condition and false otherwise.
+         * @return A reference to this set.
+         */
+        template<typename func>
+        MtmFlatSet& getSubSet(func condition){
+            elements.erase(std::remove_if(elements.begin(), elements.end(),
+                                          [&condition](const Type& elem) {
+                                              return !condition(elem);
+                                          }),
+                           elements.end());
+            return *this;
+        }
+
+        /**
+         * Get a subset of this set, that contains all the elements in the set,
+         * that meet a given condition.
+         * @tparam func - A function of an object-function that receive 1
+         *  argument, of the same type as an element in the set, and returns
+         *  a bool.
+         * @param condition - function (or object-function) that returns true
+         * if the element is meeting the condition and false otherwise.
+         * @return A the new set.
+         */
+        template<typename func>
+        MtmFlatSet getSubSet(func condition) const{
+            MtmFlatSet subset(compare);
+            for (const Type& elem : elements) {
+                if (condition(elem)) subset.elements.push_back(elem);
+            }
+            return subset;
+        }
+    };
+} // namespace mtm
+
+#endif //MTM4_FLAT_SET_H
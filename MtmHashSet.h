@@ -0,0 +1,690 @@
+#ifndef MTM4_HASH_SET_H
+#define MTM4_HASH_SET_H
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "exceptions.h"
+#include "MtmSetIterator.h"
+
+namespace mtm{
+    /**
+     * A set with the same interface as MtmSet, backed by an open-addressing
+     * hash table. insert, find, contains and erase take constant time on
+     * average.
+     * The elements are kept contiguously (in no particular order), and the
+     * table only holds their positions, so iteration is a linear walk.
+     * An element stays in its position until it is erased, and the
+     * position is then reused by a later insertion, so erasing an element
+     * doesn't invalidate iterators to the other elements (as in MtmSet).
+     * An erased element is destroyed at once, so the set doesn't hold on
+     * to what it owned.
+     * @tparam Type The type of an element on the set.
+     *      Required to implement:
+     *                             - operator ==
+     *                             - copy constructor
+     * @tparam Hash A function-object that receives an element and returns
+     *  its hash (std::size_t). Equal elements must have equal hashes.
+     * @tparam KeyEqual A function-object that receives two elements and
+     *  returns true if they are equal.
+     * If both Hash and KeyEqual declare a type named is_transparent, find
+     * and contains also accept any key type they accept, so the set can be
+     * probed without constructing a Type (e.g. a set of std::string with a
+     * const char*, using MtmStringHash and MtmStringEqual).
+     */
+    template<typename Type, typename Hash = std::hash<Type>,
+            typename KeyEqual = std::equal_to<Type> >
+    class MtmHashSet{
+        /**
+         * Values of a table slot that doesn't hold a position, and the
+         * smallest capacity of a non-empty table.
+         */
+        enum { SLOT_EMPTY = -1, SLOT_DELETED = -2, MIN_CAPACITY = 8 };
+
+        /**
+         * Raw storage for one element. An element is constructed in it
+         * only while its position is used.
+         */
+        typedef typename std::aligned_storage<sizeof(Type),
+                alignof(Type)>::type Storage;
+
+        /**
+         * Properties of class MtmHashSet
+         * elements - The storage of the elements of the set, contiguous. The
+         *  storage of an erased element is left in place, with no element in
+         *  it, until its position is reused. It never reallocates by
+         *  itself: relocate moves the elements to a bigger one.
+         * hashes - hashes[i] is the hash of elements[i].
+         * used - used[i] is false if elements[i] was erased.
+         * free_positions - The positions of the erased elements.
+         * slots - The open-addressing table. Every slot is SLOT_EMPTY,
+         *  SLOT_DELETED, or a position in elements.
+         * deleted_count - Amount of SLOT_DELETED slots in the table.
+         */
+        std::vector<Storage> elements;
+        std::vector<std::size_t> hashes;
+        std::vector<bool> used;
+        std::vector<int> free_positions;
+        std::vector<int> slots;
+        std::size_t deleted_count;
+        Hash hasher;
+        KeyEqual equal;
+
+        std::size_t mask() const {
+            return slots.size() - 1;
+        }
+
+        Type& element(std::size_t position) {
+            return *reinterpret_cast<Type*>(&elements[position]);
+        }
+
+        const Type& element(std::size_t position) const {
+            return *reinterpret_cast<const Type*>(&elements[position]);
+        }
+
+        /**
+         * Destroy the elements in all the used positions, and leave the
+         * storage as it is.
+         */
+        void destroyAll() {
+            for (std::size_t i = 0; i < elements.size(); ++i) {
+                if (used[i]) element(i).~Type();
+            }
+        }
+
+        /**
+         * Construct the elements of another set in the same positions, in
+         * storage of the same size. If a copy throws, the copies made so
+         * far are destroyed.
+         */
+        void copyElements(const MtmHashSet& other) {
+            elements.reserve(other.elements.size());
+            elements.resize(other.elements.size());
+            std::size_t i = 0;
+            try {
+                for ( ; i < elements.size(); ++i) {
+                    if (!other.used[i]) continue;
+                    new (&elements[i]) Type(other.element(i));
+                }
+            } catch (...) {
+                while (i-- > 0) {
+                    if (other.used[i]) element(i).~Type();
+                }
+                elements.clear();
+                throw;
+            }
+        }
+
+        /**
+         * Move the elements to storage of a bigger capacity, in the same
+         * positions. Elements are moved if that can't throw, and copied
+         * otherwise, so a throwing copy leaves the set as it was.
+         */
+        void relocate(std::size_t capacity) {
+            hashes.reserve(capacity);
+            used.reserve(capacity);
+            std::vector<Storage> moved;
+            moved.reserve(capacity);
+            moved.resize(elements.size());
+            std::size_t i = 0;
+            try {
+                for ( ; i < elements.size(); ++i) {
+                    if (!used[i]) continue;
+                    new (&moved[i]) Type(std::move_if_noexcept(element(i)));
+                }
+            } catch (...) {
+                while (i-- > 0) {
+                    if (used[i]) reinterpret_cast<Type*>(&moved[i])->~Type();
+                }
+                throw;
+            }
+            destroyAll();
+            elements.swap(moved);
+        }
+
+        /**
+         * Find the slot that holds an element equal to elem.
+         * @param elem An element, or a key that Hash and KeyEqual accept.
+         * @return The index of the slot, or -1 if there is no such element.
+         */
+        template<typename Key>
+        long findSlot(const Key& elem, std::size_t hash) const {
+            if (slots.empty()) return -1;
+            std::size_t index = hash & mask();
+            while (slots[index] != SLOT_EMPTY) {
+                int position = slots[index];
+                if (position >= 0 && hashes[position] == hash
+                    && equal(element(position), elem)) {
+                    return long(index);
+                }
+                index = (index + 1) & mask();
+            }
+            return -1;
+        }
+
+        /**
+         * Find the slot that holds a given position in elements.
+         * Assumes the position is in the table.
+         */
+        std::size_t slotOfPosition(int position) const {
+            std::size_t index = hashes[position] & mask();
+            while (slots[index] != position) index = (index + 1) & mask();
+            return index;
+        }
+
+        /**
+         * Put a position into the first free slot of its probe sequence.
+         * Assumes there is a free slot.
+         */
+        void placePosition(int position) {
+            std::size_t index = hashes[position] & mask();
+            while (slots[index] >= 0) index = (index + 1) & mask();
+            if (slots[index] == SLOT_DELETED) --deleted_count;
+            slots[index] = position;
+        }
+
+        /**
+         * Rebuild the table with a given capacity (a power of 2), dropping
+         * all deleted slots.
+         */
+        void rehash(std::size_t capacity) {
+            slots.assign(capacity, SLOT_EMPTY);
+            deleted_count = 0;
+            for (std::size_t i = 0; i < elements.size(); ++i) {
+                if (used[i]) placePosition(int(i));
+            }
+        }
+
+        /**
+         * Make sure one more element can be added, while keeping the table
+         * at most 3/4 full (including deleted slots).
+         */
+        void reserveOneMore() {
+            std::size_t count = std::size_t(size());
+            std::size_t taken = count + deleted_count + 1;
+            if (!slots.empty() && taken * 4 <= slots.size() * 3) return;
+            std::size_t capacity = MIN_CAPACITY;
+            while ((count + 1) * 2 > capacity) capacity *= 2;
+            rehash(capacity);
+        }
+
+        /**
+         * Add an element that isn't in the set, in the position of an erased
+         * element if there is one.
+         * @return The position of the new element.
+         */
+        std::size_t add(const Type& elem, std::size_t hash) {
+            reserveOneMore();
+            int position;
+            if (free_positions.empty()) {
+                if (elements.size() == elements.capacity()) {
+                    relocate(std::max<std::size_t>(MIN_CAPACITY,
+                                                   elements.size() * 2));
+                }
+                position = int(elements.size());
+                /* Within the capacity, so none of these allocate */
+                elements.push_back(Storage());
+                try {
+                    new (&elements[position]) Type(elem);
+                } catch (...) {
+                    elements.pop_back();
+                    throw;
+                }
+                hashes.push_back(hash);
+                used.push_back(true);
+            } else {
+                position = free_positions.back();
+                new (&elements[position]) Type(elem);
+                free_positions.pop_back();
+                hashes[position] = hash;
+                used[position] = true;
+            }
+            placePosition(position);
+            return std::size_t(position);
+        }
+
+        /**
+         * Remove the element in a given slot, and destroy it. The other
+         * elements stay in their positions.
+         */
+        void eraseSlot(std::size_t index) {
+            int position = slots[index];
+            free_positions.push_back(position);
+            slots[index] = SLOT_DELETED;
+            ++deleted_count;
+            used[position] = false;
+            element(std::size_t(position)).~Type();
+        }
+
+        /**
+         * Remove all the elements that a given predicate rejects, in one pass.
+         */
+        template<typename func>
+        void eraseIf(func reject) {
+            for (std::size_t i = 0; i < elements.size(); ++i) {
+                if (used[i] && reject(element(i))) {
+                    eraseSlot(slotOfPosition(int(i)));
+                }
+            }
+        }
+
+        /**
+         * @return The first position, from a given one, that holds an
+         *  element (that wasn't erased), or elements.size() if there is none.
+         */
+        std::size_t firstUsed(std::size_t position) const {
+            while (position < elements.size() && !used[position]) ++position;
+            return position;
+        }
+
+    public:
+        /**
+         * The position of an iterator: a used index in elements.
+         */
+        struct Cursor{
+            const MtmHashSet* set;
+            std::size_t position;
+
+            Cursor() : set(nullptr), position(0) {
+            }
+
+            Cursor(const MtmHashSet* set, std::size_t position)
+                    : set(set), position(position) {
+            }
+
+            bool isEnd() const {
+                return !set || position >= set->elements.size();
+            }
+
+            const Type& get() const {
+                return set->element(position);
+            }
+
+            void next() {
+                position = set->firstUsed(position + 1);
+            }
+
+            bool operator==(const Cursor& rhs) const {
+                return set == rhs.set && position == rhs.position;
+            }
+        };
+
+        typedef MtmSetIterator<Type, Cursor, false> iterator;
+        typedef MtmSetIterator<Type, Cursor, true> const_iterator;
+
+        /**
+         * Empty constructor
+         * Creates an empty set
+         */
+        MtmHashSet() : deleted_count(0) {
+        }
+
+        /**
+         * Copy constructor
+         * The elements are copied to the same positions.
+         * @param other The set to copy.
+         */
+        MtmHashSet(const MtmHashSet& other)
+                : hashes(other.hashes), used(other.used),
+                  free_positions(other.free_positions), slots(other.slots),
+                  deleted_count(other.deleted_count), hasher(other.hasher),
+                  equal(other.equal) {
+            copyElements(other);
+        }
+
+        /**
+         * Move constructor
+         * @param other The set to move from. It is left empty.
+         */
+        MtmHashSet(MtmHashSet&& other) noexcept : MtmHashSet() {
+            swap(other);
+        }
+
+        /**
+         * Copy assignment operator. If a copy throws, the set doesn't
+         * change.
+         */
+        MtmHashSet& operator=(const MtmHashSet& other){
+            if (this == &other) return *this;
+            MtmHashSet copied(other);
+            swap(copied);
+            return *this;
+        }
+
+        /**
+         * Move assignment operator. The elements of this set are destroyed
+         * with other.
+         */
+        MtmHashSet& operator=(MtmHashSet&& other) noexcept{
+            swap(other);
+            return *this;
+        }
+
+        /**
+         * Destructor
+         */
+        ~MtmHashSet(){
+            destroyAll();
+        }
+
+        /**
+         * Swap the contents of two sets, without copying elements.
+         */
+        void swap(MtmHashSet& other) noexcept{
+            elements.swap(other.elements);
+            hashes.swap(other.hashes);
+            used.swap(other.used);
+            free_positions.swap(other.free_positions);
+            slots.swap(other.slots);
+            std::swap(deleted_count, other.deleted_count);
+            std::swap(hasher, other.hasher);
+            std::swap(equal, other.equal);
+        }
+
+        /**
+         * Insert a new element to the set, doesn't insert if there is already
+         *  an equal element in the set.
+         * If an element was't inserted, all iterators should stay valid.
+         * @param elem The element to insert to the set
+         * @return An iterator to the inserted element, or to the equal
+         * element if the element wasn't inserted.
+         */
+        iterator insert(const Type& elem){
+            std::size_t hash = hasher(elem);
+            long index = findSlot(elem, hash);
+            if (index >= 0) return iterator(Cursor(this, slots[index]));
+            return iterator(Cursor(this, add(elem, hash)));
+        }
+
+        /**
+         * Remove an element from the set. If there is no element equal to
+         *  elem in the set, does nothing.
+         * If an element wasn't removed, all iterators should stay valid.
+         * @param elem the element to remove.
+         */
+        void erase(const Type& elem){
+            long index = findSlot(elem, hasher(elem));
+            if (index >= 0) eraseSlot(std::size_t(index));
+        }
+
+        /**
+         * Remove the element the iterator points to from the set.
+         * Iterator to another set is undefined.
+         * @param it The iterator to the element to the set.
+         */
+        void erase(const iterator& it){
+            if (it.cursor().isEnd()) throw NodeIsEndException();
+            eraseSlot(slotOfPosition(int(it.cursor().position)));
+        }
+
+        /**
+         * Get the amount of elements in the set.
+         * @return The amount of elements in the set.
+         */
+        int size() const{
+            return int(elements.size() - free_positions.size());
+        }
+
+        /**
+         * Check if the set is empty.
+         * @return true is the set is empty.
+         */
+        bool empty() const{
+            return size() == 0;
+        }
+
+        /**
+         * Empty the set, free all allocated memory in the set.
+         */
+        void clear(){
+            destroyAll();
+            elements.clear();
+            hashes.clear();
+            used.clear();
+            free_positions.clear();
+            slots.clear();
+            deleted_count = 0;
+        }
+
+        /**
+         * Get an iterator to the first element in the set.
+         * If set is empty, return the same as end.
+         */
+        iterator begin(){
+            return iterator(Cursor(this, firstUsed(0)));
+        }
+
+        /**
+         * Get a const_iterator to the first element in the set.
+         * If set is empty, return the same as end.
+         */
+        const_iterator begin() const{
+            return const_iterator(Cursor(this, firstUsed(0)));
+        }
+
+        /**
+         * Returns an iterator referring to the past-the-end element in the set.
+         * @return Iterator to past-the-end element.
+         */
+        iterator end(){
+            return iterator();
+        }
+
+        /**
+         * Returns a const_iterator referring to the past-the-end element in
+         * the set.
+         * @return const_iterator to past-the-end element.
+         */
+        const_iterator end() const{
+            return const_iterator();
+        }
+
+        /**
+         * Find an element in the set.
+         * @param elem The element to find
+         * @return An iterator that points to the elem, or end() if the
+         *  element isn't in the set.
+         */
+        iterator find(const Type& elem){
+            long index = findSlot(elem, hasher(elem));
+            if (index < 0) return end();
+            return iterator(Cursor(this, slots[index]));
+        }
+
+        /**
+         * Find an element in the set.
+         * @param elem The element to find
+         * @return A const_iterator that points to the elem, or end() if the
+         *  element isn't in the set.
+         */
+        const_iterator find(const Type& elem) const{
+            long index = findSlot(elem, hasher(elem));
+            if (index < 0) return end();
+            return const_iterator(Cursor(this, slots[index]));
+        }
+
+        /**
+         * Check if an element is in the set.
+         * @param elem The element to check if it's in the set.
+         * @return True if the element is in the set, false otherwise.
+         */
+        bool contains(const Type& elem) const{
+            return findSlot(elem, hasher(elem)) >= 0;
+        }
+
+        /**
+         * Find an element equal to a key of another type, without
+         *  constructing a Type from it. Only if Hash and KeyEqual are
+         *  transparent.
+         * @param key The key to find, e.g. a const char* in a set of strings.
+         * @return An iterator that points to the element, or end() if there
+         *  is no such element.
+         */
+        template<typename Key, typename H = Hash, typename E = KeyEqual,
+                typename = typename H::is_transparent,
+                typename = typename E::is_transparent>
+        iterator find(const Key& key){
+            long index = findSlot(key, hasher(key));
+            if (index < 0) return end();
+            return iterator(Cursor(this, slots[index]));
+        }
+
+        /**
+         * Find an element equal to a key of another type, without
+         *  constructing a Type from it. Only if Hash and KeyEqual are
+         *  transparent.
+         * @param key The key to find, e.g. a const char* in a set of strings.
+         * @return A const_iterator that points to the element, or end() if
+         *  there is no such element.
+         */
+        template<typename Key, typename H = Hash, typename E = KeyEqual,
+                typename = typename H::is_transparent,
+                typename = typename E::is_transparent>
+        const_iterator find(const Key& key) const{
+            long index = findSlot(key, hasher(key));
+            if (index < 0) return end();
+            return const_iterator(Cursor(this, slots[index]));
+        }
+
+        /**
+         * Check if there is an element equal to a key of another type,
+         *  without constructing a Type from it. Only if Hash and KeyEqual are
+         *  transparent.
+         * @param key The key to check, e.g. a const char* in a set of strings.
+         * @return True if there is such an element, false otherwise.
+         */
+        template<typename Key, typename H = Hash, typename E = KeyEqual,
+                typename = typename H::is_transparent,
+                typename = typename E::is_transparent>
+        bool contains(const Key& key) const{
+            return findSlot(key, hasher(key)) >= 0;
+        }
+
+        /**
+         * Check if this set is a superset of a given set.
+         * @param subset The set to check if it's a subset.
+         * @return True if the given set is a subset of this set.
+         */
+        bool isSuperSetOf(const MtmHashSet& subset) const{
+            if (subset.size() > this->size()) return false;
+            for (std::size_t i = 0; i < subset.elements.size(); ++i) {
+                if (!subset.used[i]) continue;
+                if (findSlot(subset.element(i), subset.hashes[i]) < 0) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        /**
+         * Check if two set are equal, meaning, they contain the same elements.
+         * @param rhs The set right of the == operator.
+         * @return true if the two set contain the same elements, false
+         *  otherwise.
+         */
+        bool operator==(const MtmHashSet& rhs) const{
+            return this->size() == rhs.size() && this->isSuperSetOf(rhs);
+        }
+
+        /**
+         * Check if two set are equal, meaning, they contain the same elements.
+         * @param rhs The set right of the != operator.
+         * @return false if the two set contain the same elements, true
+         *  otherwise.
+         */
+        bool operator!=(const MtmHashSet& rhs) const{
+            return !(*this == rhs);
+        }
+
+        /**
+         * Insert all the elements in the given set to this set (union).
+         * @param set The set to insert all the elements from.
+         * @return A reference to this set.
+         */
+        MtmHashSet& unite(const MtmHashSet& set){
+            if (this == &set) return *this;
+            for (std::size_t i = 0; i < set.elements.size(); ++i) {
+                if (!set.used[i]) continue;
+                if (findSlot(set.element(i), set.hashes[i]) >= 0) continue;
+                add(set.element(i), set.hashes[i]);
+            }
+            return *this;
+        }
+
+        /**
+         * Returns a new set that is an union of this set, and a given set.
+         * @param set The other set (other than this) to be in the union.
+         * @return The new set.
+         */
+        MtmHashSet unite(const MtmHashSet& set) const{
+            MtmHashSet copied(*this);
+            copied.unite(set);
+            return copied;
+        }
+
+        /**
+         * Remove all the elements from this set, that are not in the given set
+         * (intersection).
+         * @param set The other set in the intersection.
+         * @return A reference to this set.
+         */
+        MtmHashSet& intersect(const MtmHashSet& set){
+            if (this == &set) return *this;
+            eraseIf([&set](const Type& elem) { return !set.contains(elem); });
+            return *this;
+        }
+
+        /**
+         * Returns a new set that is an intersection of this set,
+         *  and a given set.
+         * @param set The other set (other than this) to be in the intersection.
+         * @return The new set.
+         */
+        MtmHashSet intersect(const MtmHashSet& set) const{
+            MtmHashSet copied(*this);
+            copied.intersect(set);
+            return copied;
+        }
+
+        /**
+         * Remove all the elements in the set, that doesn't meet a given
+         *  condition.
+         * @tparam func - A function of an object-function that receive 1
+         *  argument, of the same type as an element in the set, and returns
+         *  a bool.
+         * @param condition - function (or object-function) that returns true
+         * if the element is meeting the condition and false otherwise.
+         * @return A reference to this set.
+         */
+        template<typename func>
+        MtmHashSet& getSubSet(func condition){
+            eraseIf([&condition](const Type& elem) {
+                return !condition(elem);
+            });
+            return *this;
+        }
+
+        /**
+         * Get a subset of this set, that contains all the elements in the set,
+         * that meet a given condition.
+         * @tparam func - A function of an object-function that receive 1
+         *  argument, of the same type as an element in the set, and returns
+         *  a bool.
+         * @param condition - function (or object-function) that returns true
+         * if the element is meeting the condition and false otherwise.
+         * @return A the new set.
+         */
+        template<typename func>
+        MtmHashSet getSubSet(func condition) const{
+            MtmHashSet copied(*this);
+            copied.getSubSet(condition);
+            return copied;
+        }
+    };
+} // namespace mtm
+
+#endif //MTM4_HASH_SET_H
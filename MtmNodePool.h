@@ -0,0 +1,246 @@
+#ifndef MTM4_NODE_POOL_H
+#define MTM4_NODE_POOL_H
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace mtm{
+    /**
+     * Storage for nodes inside the object that owns them.
+     * @tparam Node The type of the nodes.
+     * @tparam Count The amount of nodes.
+     */
+    template<typename Node, std::size_t Count>
+    class MtmInlineNodes{
+        typename std::aligned_storage<sizeof(Node), alignof(Node)>::type
+                nodes[Count];
+
+    protected:
+        Node* inlineNodes() {
+            return reinterpret_cast<Node*>(nodes);
+        }
+    };
+
+    /**
+     * No inline storage. Takes no space when inherited.
+     */
+    template<typename Node>
+    class MtmInlineNodes<Node, 0>{
+    protected:
+        Node* inlineNodes() {
+            return nullptr;
+        }
+    };
+
+    /**
+     * A pool of nodes for a linked container.
+     * Nodes are carved out of chunks, each chunk is a single allocation
+     * holding many nodes. Destroyed nodes are kept in a free list and reused
+     * by the next created node. Memory is returned only by release(), which
+     * frees every chunk at once.
+     * The chunks grow geometrically, so n nodes cost O(log n) allocations.
+     * The first InlineCount nodes are stored inside the pool itself, so
+     * a container that never holds more than that never allocates.
+     * @tparam Node The type of the nodes. Must be at least as big as a
+     *  pointer.
+     * @tparam InlineCount The amount of nodes stored inside the pool.
+     */
+    template<typename Node, std::size_t InlineCount = 0>
+    class MtmNodePool : private MtmInlineNodes<Node, InlineCount>{
+        enum { MIN_CHUNK_NODES = 8 };
+
+        /**
+         * The header at the start of every chunk, chaining all the chunks.
+         */
+        struct Chunk{
+            Chunk* next;
+        };
+
+        /**
+         * A destroyed node, chained in the free list.
+         */
+        struct FreeNode{
+            FreeNode* next;
+        };
+
+        /**
+         * Offset of the first node in a chunk. Rounded up so the nodes are
+         * aligned.
+         */
+        static std::size_t nodesOffset() {
+            std::size_t align = alignof(Node);
+            return (sizeof(Chunk) + align - 1) / align * align;
+        }
+
+        /**
+         * Properties of class MtmNodePool
+         * chunks - All the chunks allocated by the pool.
+         * free_nodes - Nodes that were destroyed and can be reused.
+         * unused - The first node in the last chunk (or in the inline
+         *  storage) that was never used.
+         * unused_count - The amount of never used nodes after unused.
+         * capacity - The total amount of nodes in all the chunks and the
+         *  inline storage.
+         */
+        Chunk* chunks;
+        FreeNode* free_nodes;
+        Node* unused;
+        std::size_t unused_count;
+        std::size_t capacity;
+
+        /**
+         * Allocate a new chunk with a given amount of nodes, and make it
+         * the source of new nodes.
+         * Never used nodes left in the previous chunk are moved to the free
+         * list, so they are not lost.
+         * @throws std::bad_alloc if the allocation fails.
+         */
+        void addChunk(std::size_t node_count) {
+            void* memory = ::operator new(nodesOffset()
+                                          + node_count * sizeof(Node));
+            for ( ; unused_count > 0; --unused_count) {
+                deallocate(unused++);
+            }
+            Chunk* chunk = static_cast<Chunk*>(memory);
+            chunk->next = chunks;
+            chunks = chunk;
+            unused = reinterpret_cast<Node*>(static_cast<char*>(memory)
+                                             + nodesOffset());
+            unused_count = node_count;
+            capacity += node_count;
+        }
+
+        /**
+         * Get memory for a single node, without constructing it.
+         */
+        void* allocate() {
+            if (free_nodes) {
+                FreeNode* node = free_nodes;
+                free_nodes = node->next;
+                return node;
+            }
+            if (unused_count == 0) {
+                addChunk(capacity < std::size_t(MIN_CHUNK_NODES)
+                         ? std::size_t(MIN_CHUNK_NODES) : capacity);
+            }
+            --unused_count;
+            return unused++;
+        }
+
+        /**
+         * Return the memory of a single node (already destroyed) to the pool.
+         */
+        void deallocate(void* memory) {
+            FreeNode* node = static_cast<FreeNode*>(memory);
+            node->next = free_nodes;
+            free_nodes = node;
+        }
+
+    public:
+        /**
+         * Empty constructor
+         * Creates a pool with no chunks. Doesn't allocate.
+         */
+        MtmNodePool() : chunks(nullptr), free_nodes(nullptr),
+                        unused(this->inlineNodes()), unused_count(InlineCount),
+                        capacity(InlineCount) {
+        }
+
+        /**
+         * Disable copy constructor and assignment operator. A copied
+         * container should create its own nodes in its own pool.
+         */
+        MtmNodePool(const MtmNodePool&) = delete;
+        MtmNodePool &operator=(const MtmNodePool&) = delete;
+
+        /**
+         * Destructor
+         * Frees all the chunks. All the nodes should be destroyed before.
+         */
+        ~MtmNodePool() {
+            release();
+        }
+
+        /**
+         * Create a node in the pool.
+         * @param args The arguments for the constructor of the node.
+         * @return A pointer to the new node.
+         */
+        template<typename... Args>
+        Node* create(Args&&... args) {
+            void* memory = allocate();
+            try {
+                return new (memory) Node(std::forward<Args>(args)...);
+            } catch (...) {
+                deallocate(memory);
+                throw;
+            }
+        }
+
+        /**
+         * Destroy a node that was created by this pool. Its memory is kept
+         * for the next created node.
+         * @param node The node to destroy.
+         */
+        void destroy(Node* node) {
+            node->~Node();
+            deallocate(node);
+        }
+
+        /**
+         * Make sure the next node_count nodes can be created with no more
+         * than one allocation (which is done now).
+         * @param node_count The amount of nodes that are going to be created.
+         */
+        void reserve(std::size_t node_count) {
+            if (node_count <= unused_count) return;
+            addChunk(node_count);
+        }
+
+        /**
+         * Free all the chunks. All the nodes should be destroyed before.
+         * Takes time proportional to the amount of chunks, not nodes.
+         * The inline nodes become available again.
+         */
+        void release() {
+            while (chunks) {
+                Chunk* next = chunks->next;
+                ::operator delete(chunks);
+                chunks = next;
+            }
+            free_nodes = nullptr;
+            unused = this->inlineNodes();
+            unused_count = InlineCount;
+            capacity = InlineCount;
+        }
+
+        /**
+         * Exchange all the chunks and nodes of this pool with a given pool.
+         * Nodes created by one pool can then be destroyed by the other.
+         * Only pools without inline nodes can be swapped, since inline
+         * nodes can't change their owner.
+         */
+        void swap(MtmNodePool& other) {
+            static_assert(InlineCount == 0,
+                          "Pools with inline nodes can't be swapped");
+            std::swap(chunks, other.chunks);
+            std::swap(free_nodes, other.free_nodes);
+            std::swap(unused, other.unused);
+            std::swap(unused_count, other.unused_count);
+            std::swap(capacity, other.capacity);
+        }
+
+        /**
+         * Get the amount of allocations the pool currently holds.
+         */
+        std::size_t chunkCount() const {
+            std::size_t count = 0;
+            for (Chunk* chunk = chunks; chunk; chunk = chunk->next) ++count;
+            return count;
+        }
+    };
+} // namespace mtm
+
+#endif //MTM4_NODE_POOL_H
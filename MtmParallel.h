@@ -0,0 +1,280 @@
+#ifndef MTM4_PARALLEL_H
+#define MTM4_PARALLEL_H
+
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <thread>
+#include <vector>
+#include "MtmSet.h"
+
+namespace mtm{
+    /**
+     * Parallel versions of the MtmSet operations, for very large sets.
+     * Membership tests in MtmSet are linear, so unite, intersect and
+     * isSuperSetOf of two sets take time proportional to the product of
+     * their sizes. The parallel versions split that work between threads:
+     * the elements of one set are divided into equal contiguous ranges,
+     * and each thread tests the elements of its range. The result set is
+     * then assembled by the calling thread, in the order of the serial
+     * operation, so the results are identical to the serial ones, element
+     * order included.
+     * Every call starts its own threads (there is no pool of threads) and
+     * joins them before it returns, and uses only as many threads as its
+     * work pays for (see
+     * MIN_WORK_PER_THREAD), so small sets are handled by the calling thread
+     * alone.
+     * The sets must not be changed by other threads during a call.
+     */
+    namespace parallel{
+        /**
+         * Resolve the amount of threads to use: 0 means the amount of cores.
+         */
+        inline unsigned threadCount(unsigned threads) {
+            if (threads > 0) return threads;
+            unsigned cores = std::thread::hardware_concurrency();
+            return cores > 0 ? cores : 1;
+        }
+
+        enum {
+            /**
+             * The least work, in element comparisons, that is worth a
+             * thread of its own. Starting and joining a thread costs about
+             * 12us, while comparing two short strings costs about 2ns (see
+             * bench/MtmParallel_bench.cpp), so a thread needs about 2^19
+             * comparisons for its start to cost 1% of its work. Below that,
+             * the serial loop is faster. The limit only keeps small calls
+             * off threads; whether more threads are faster above it depends
+             * on the cores of the machine.
+             */
+            MIN_WORK_PER_THREAD = 1 << 19
+        };
+
+        /**
+         * The amount of ranges to split [0, count) to: one per thread, but
+         * no more than the work pays for, and at least one.
+         * @param cost The estimated comparisons to handle one index.
+         */
+        inline std::size_t rangeCount(std::size_t count, std::size_t cost,
+                                      unsigned threads) {
+            std::size_t ranges = threadCount(threads);
+            std::size_t paid = count * cost / MIN_WORK_PER_THREAD;
+            if (ranges > paid) ranges = paid;
+            if (ranges > count) ranges = count;
+            return ranges > 0 ? ranges : 1;
+        }
+
+        /**
+         * Run a function on [0, count), split into contiguous ranges, one
+         * per thread (see rangeCount). The calling thread runs the first
+         * range itself.
+         * An exception thrown in any thread is rethrown after all of them
+         * end. If a thread can't be started, the threads that were started
+         * are joined, and the exception of std::thread is rethrown.
+         * @param cost The estimated comparisons to handle one index.
+         * @param work A function that receives the first and last (past
+         *  the end) index of a range.
+         */
+        template<typename Work>
+        void forEachRange(std::size_t count, std::size_t cost,
+                          unsigned threads, Work work) {
+            std::size_t ranges = rangeCount(count, cost, threads);
+            if (ranges <= 1) {
+                work(std::size_t(0), count);
+                return;
+            }
+            std::vector<std::exception_ptr> errors(ranges);
+            std::vector<std::thread> workers;
+            workers.reserve(ranges - 1);
+            try {
+                for (std::size_t i = 1; i < ranges; ++i) {
+                    std::size_t first = count * i / ranges;
+                    std::size_t last = count * (i + 1) / ranges;
+                    workers.push_back(std::thread([&work, &errors, i, first,
+                                                          last]() {
+                        try {
+                            work(first, last);
+                        } catch (...) {
+                            errors[i] = std::current_exception();
+                        }
+                    }));
+                }
+            } catch (...) {
+                /* A thread that is destroyed before it is joined calls
+                 * std::terminate */
+                for (std::thread& worker : workers) worker.join();
+                throw;
+            }
+            try {
+                work(std::size_t(0), count / ranges);
+            } catch (...) {
+                errors[0] = std::current_exception();
+            }
+            for (std::thread& worker : workers) worker.join();
+            for (const std::exception_ptr& error : errors) {
+                if (error) std::rethrow_exception(error);
+            }
+        }
+
+        /**
+         * Get pointers to the elements of a set, in the order of the set,
+         * so they can be divided between threads.
+         */
+        template<typename Set, typename Type>
+        std::vector<const Type*> elementsOf(const Set& set) {
+            std::vector<const Type*> elements;
+            elements.reserve(std::size_t(set.size()));
+            for (const Type& elem : set) elements.push_back(&elem);
+            return elements;
+        }
+
+        /**
+         * Test every element with a condition, in parallel.
+         * @param cost The estimated comparisons of one test.
+         * @return For every element, 1 if it meets the condition and 0
+         *  otherwise.
+         */
+        template<typename Type, typename func>
+        std::vector<char> mark(const std::vector<const Type*>& elements,
+                               func condition, std::size_t cost,
+                               unsigned threads) {
+            std::vector<char> marks(elements.size());
+            forEachRange(elements.size(), cost, threads,
+                         [&](std::size_t first, std::size_t last) {
+                for (std::size_t i = first; i < last; ++i) {
+                    marks[i] = condition(*elements[i]) ? 1 : 0;
+                }
+            });
+            return marks;
+        }
+
+        /**
+         * Append the marked elements to a set.
+         */
+        template<typename Set, typename Type>
+        void appendMarked(Set& set, const std::vector<const Type*>& elements,
+                          const std::vector<char>& marks) {
+            MtmSetAppender<Set> appender(set);
+            std::size_t marked = 0;
+            for (char is_marked : marks) marked += std::size_t(is_marked);
+            appender.reserve(marked);
+            for (std::size_t i = 0; i < elements.size(); ++i) {
+                if (marks[i]) appender.append(*elements[i]);
+            }
+        }
+    } // namespace parallel
+
+    /**
+     * Returns a new set that is an union of two sets. Same result as
+     *  set1.unite(set2) on a const set1.
+     * @param set1 The first set. Its elements come first in the result.
+     * @param set2 The second set.
+     * @param threads The amount of threads to use, 0 for the amount of cores.
+     * @return The new set.
+     */
+    template<typename Type, std::size_t InlineCapacity, typename Checking>
+    MtmSet<Type, InlineCapacity, Checking> parallelUnite(
+            const MtmSet<Type, InlineCapacity, Checking>& set1,
+            const MtmSet<Type, InlineCapacity, Checking>& set2,
+            unsigned threads = 0) {
+        std::vector<const Type*> elements =
+                parallel::elementsOf<MtmSet<Type, InlineCapacity, Checking>,
+                        Type>(set2);
+        std::vector<char> missing = parallel::mark(elements,
+                [&set1](const Type& elem) { return !set1.contains(elem); },
+                std::size_t(set1.size()), threads);
+        MtmSet<Type, InlineCapacity, Checking> united(set1);
+        parallel::appendMarked(united, elements, missing);
+        return united;
+    }
+
+    /**
+     * Returns a new set that is an intersection of two sets. Same result
+     *  as set1.intersect(set2) on a const set1.
+     * @param set1 The first set. The result keeps its order.
+     * @param set2 The second set.
+     * @param threads The amount of threads to use, 0 for the amount of cores.
+     * @return The new set.
+     */
+    template<typename Type, std::size_t InlineCapacity, typename Checking>
+    MtmSet<Type, InlineCapacity, Checking> parallelIntersect(
+            const MtmSet<Type, InlineCapacity, Checking>& set1,
+            const MtmSet<Type, InlineCapacity, Checking>& set2,
+            unsigned threads = 0) {
+        std::vector<const Type*> elements =
+                parallel::elementsOf<MtmSet<Type, InlineCapacity, Checking>,
+                        Type>(set1);
+        std::vector<char> common = parallel::mark(elements,
+                [&set2](const Type& elem) { return set2.contains(elem); },
+                std::size_t(set2.size()), threads);
+        MtmSet<Type, InlineCapacity, Checking> intersected;
+        parallel::appendMarked(intersected, elements, common);
+        return intersected;
+    }
+
+    /**
+     * Get a subset of a set, that contains all the elements in the set that
+     *  meet a given condition. Same result as set.getSubSet(condition) on
+     *  a const set.
+     * @tparam func - A function of an object-function that receive 1
+     *  argument, of the same type as an element in the set, and returns
+     *  a bool. Called from several threads at once, so it must be safe to
+     *  do so.
+     * @param set The set.
+     * @param condition - function (or object-function) that returns true
+     * if the element is meeting the condition and false otherwise.
+     * @param threads The amount of threads to use, 0 for the amount of cores.
+     * @param cost The estimated cost of one call of condition, in element
+     *  comparisons. Only a costly condition pays for threads on a set that
+     *  is not huge.
+     * @return The new set.
+     */
+    template<typename Type, std::size_t InlineCapacity, typename Checking,
+            typename func>
+    MtmSet<Type, InlineCapacity, Checking> parallelGetSubSet(
+            const MtmSet<Type, InlineCapacity, Checking>& set,
+            func condition, unsigned threads = 0, std::size_t cost = 1) {
+        std::vector<const Type*> elements =
+                parallel::elementsOf<MtmSet<Type, InlineCapacity, Checking>,
+                        Type>(set);
+        std::vector<char> kept = parallel::mark(elements, condition, cost,
+                                                threads);
+        MtmSet<Type, InlineCapacity, Checking> subset;
+        parallel::appendMarked(subset, elements, kept);
+        return subset;
+    }
+
+    /**
+     * Check if a set is a superset of another set. Same result as
+     *  set.isSuperSetOf(subset). Threads stop as soon as any of them finds
+     *  a missing element.
+     * @param set The set to check if it's a superset.
+     * @param subset The set to check if it's a subset.
+     * @param threads The amount of threads to use, 0 for the amount of cores.
+     * @return True if subset is a subset of set.
+     */
+    template<typename Type, std::size_t InlineCapacity, typename Checking>
+    bool parallelIsSuperSetOf(
+            const MtmSet<Type, InlineCapacity, Checking>& set,
+            const MtmSet<Type, InlineCapacity, Checking>& subset,
+            unsigned threads = 0) {
+        std::vector<const Type*> elements =
+                parallel::elementsOf<MtmSet<Type, InlineCapacity, Checking>,
+                        Type>(subset);
+        std::atomic<bool> missing(false);
+        parallel::forEachRange(elements.size(), std::size_t(set.size()),
+                               threads,
+                               [&](std::size_t first, std::size_t last) {
+            for (std::size_t i = first; i < last; ++i) {
+                if (missing.load(std::memory_order_relaxed)) return;
+                if (!set.contains(*elements[i])) {
+                    missing.store(true, std::memory_order_relaxed);
+                    return;
+                }
+            }
+        });
+        return !missing.load();
+    }
+} // namespace mtm
+
+#endif //MTM4_PARALLEL_H
@@ -0,0 +1,542 @@
+#ifndef MTM4_PERSISTENT_SET_H
+#define MTM4_PERSISTENT_SET_H
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <vector>
+#include "exceptions.h"
+#include "MtmSetIterator.h"
+
+namespace mtm{
+    /**
+     * A set with the same interface as MtmSet, whose copies share their
+     * elements.
+     * The elements are kept in a balanced (AVL) binary search tree of
+     * immutable nodes, owned by shared pointers. Copying a set copies one
+     * pointer. insert and erase never change a node: they create new nodes
+     * for the O(log n) nodes on the path to the changed element, and share
+     * every other node with the previous version of the set. Nodes that no
+     * version uses anymore are freed.
+     * So a copy taken as a snapshot costs O(1), and stays correct while the
+     * original changes.
+     * insert, erase, find and contains take O(log n), size takes O(1).
+     * Iteration is in ascending order. Iterators are invalidated by any
+     * change to the set (but not by changes to its copies).
+     * @tparam Type The type of an element on the set.
+     *      Required to implement:
+     *                             - copy constructor
+     * @tparam Compare A function-object that receives two elements and
+     *  returns true if the first is smaller. Two elements are equal if
+     *  neither is smaller than the other.
+     */
+    template<typename Type, typename Compare = std::less<Type> >
+    class MtmPersistentSet{
+        struct Node;
+        typedef std::shared_ptr<const Node> NodePtr;
+
+        /**
+         * A node of the tree. Never changes after it is created.
+         * height - The height of the subtree of this node (a leaf is 1).
+         * count - The amount of elements in the subtree of this node.
+         */
+        struct Node{
+            Type data;
+            NodePtr left;
+            NodePtr right;
+            int height;
+            int count;
+
+            Node(const Type& data, const NodePtr& left, const NodePtr& right)
+                    : data(data), left(left), right(right),
+                      height(1 + std::max(heightOf(left), heightOf(right))),
+                      count(1 + countOf(left) + countOf(right)) {
+            }
+        };
+
+        NodePtr root;
+        Compare compare;
+
+        static int heightOf(const NodePtr& node) {
+            return node ? node->height : 0;
+        }
+
+        static int countOf(const NodePtr& node) {
+            return node ? node->count : 0;
+        }
+
+        static NodePtr makeNode(const Type& data, const NodePtr& left,
+                                const NodePtr& right) {
+            return std::make_shared<const Node>(data, left, right);
+        }
+
+        /**
+         * Create a node with given children, whose heights differ by at most
+         * 2, rotating so the new subtree is balanced.
+         */
+        static NodePtr balance(const Type& data, const NodePtr& left,
+                               const NodePtr& right) {
+            int difference = heightOf(left) - heightOf(right);
+            if (difference > 1) {
+                if (heightOf(left->left) >= heightOf(left->right)) {
+                    return makeNode(left->data, left->left,
+                                    makeNode(data, left->right, right));
+                }
+                const NodePtr& middle = left->right;
+                return makeNode(middle->data,
+                                makeNode(left->data, left->left, middle->left),
+                                makeNode(data, middle->right, right));
+            }
+            if (difference < -1) {
+                if (heightOf(right->right) >= heightOf(right->left)) {
+                    return makeNode(right->data,
+                                    makeNode(data, left, right->left),
+                                    right->right);
+                }
+                const NodePtr& middle = right->left;
+                return makeNode(middle->data,
+                                makeNode(data, left, middle->left),
+                                makeNode(right->data, middle->right,
+                                         right->right));
+            }
+            return makeNode(data, left, right);
+        }
+
+        /**
+         * Get a version of a subtree with elem inserted.
+         * @return The same subtree if there is already an equal element in it.
+         */
+        NodePtr insertInto(const NodePtr& node, const Type& elem) const {
+            if (!node) return makeNode(elem, nullptr, nullptr);
+            if (compare(elem, node->data)) {
+                NodePtr left = insertInto(node->left, elem);
+                if (left == node->left) return node;
+                return balance(node->data, left, node->right);
+            }
+            if (compare(node->data, elem)) {
+                NodePtr right = insertInto(node->right, elem);
+                if (right == node->right) return node;
+                return balance(node->data, node->left, right);
+            }
+            return node;
+        }
+
+        /**
+         * Get a version of a non-empty subtree without its smallest element.
+         * @param smallest Set to the node of the smallest element.
+         */
+        static NodePtr removeSmallest(const NodePtr& node, NodePtr& smallest) {
+            if (!node->left) {
+                smallest = node;
+                return node->right;
+            }
+            return balance(node->data, removeSmallest(node->left, smallest),
+                           node->right);
+        }
+
+        /**
+         * Get a version of a subtree without the element equal to elem.
+         * @return The same subtree if there is no such element in it.
+         */
+        NodePtr eraseFrom(const NodePtr& node, const Type& elem) const {
+            if (!node) return node;
+            if (compare(elem, node->data)) {
+                NodePtr left = eraseFrom(node->left, elem);
+                if (left == node->left) return node;
+                return balance(node->data, left, node->right);
+            }
+            if (compare(node->data, elem)) {
+                NodePtr right = eraseFrom(node->right, elem);
+                if (right == node->right) return node;
+                return balance(node->data, node->left, right);
+            }
+            if (!node->right) return node->left;
+            NodePtr smallest;
+            NodePtr right = removeSmallest(node->right, smallest);
+            return balance(smallest->data, node->left, right);
+        }
+
+        /**
+         * Build a balanced tree of sorted, distinct elements.
+         */
+        static NodePtr build(const std::vector<const Type*>& sorted,
+                             std::size_t first, std::size_t last) {
+            if (first == last) return nullptr;
+            std::size_t middle = first + (last - first) / 2;
+            return makeNode(*sorted[middle], build(sorted, first, middle),
+                            build(sorted, middle + 1, last));
+        }
+
+        /**
+         * Keep only the elements that meet a condition. If all of them do,
+         * the tree is kept as is, so it stays shared with the copies.
+         */
+        template<typename func>
+        void keepIf(func condition) {
+            std::vector<const Type*> kept;
+            kept.reserve(std::size_t(countOf(root)));
+            for (const Type& elem : *this) {
+                if (condition(elem)) kept.push_back(&elem);
+            }
+            if (kept.size() == std::size_t(countOf(root))) return;
+            root = build(kept, 0, kept.size());
+        }
+
+        const Node* findNode(const Type& elem) const {
+            const Node* node = root.get();
+            while (node) {
+                if (compare(elem, node->data)) {
+                    node = node->left.get();
+                } else if (compare(node->data, elem)) {
+                    node = node->right.get();
+                } else {
+                    return node;
+                }
+            }
+            return nullptr;
+        }
+
+        /**
+         * The position of an iterator: the node it points to on top,
+         * under it the ancestors that come after it in order.
+         */
+        typedef std::vector<const Node*> Path;
+
+        static void pushLeftmost(Path& path, const Node* node) {
+            for ( ; node; node = node->left.get()) path.push_back(node);
+        }
+
+        static void advance(Path& path) {
+            const Node* current = path.back();
+            path.pop_back();
+            pushLeftmost(path, current->right.get());
+        }
+
+        Path firstPath() const {
+            Path path;
+            pushLeftmost(path, root.get());
+            return path;
+        }
+
+        /**
+         * @return The path to the element equal to elem, or an empty path if
+         *  there is no such element.
+         */
+        Path pathTo(const Type& elem) const {
+            Path path;
+            const Node* node = root.get();
+            while (node) {
+                if (compare(elem, node->data)) {
+                    path.push_back(node);
+                    node = node->left.get();
+                } else if (compare(node->data, elem)) {
+                    node = node->right.get();
+                } else {
+                    path.push_back(node);
+                    return path;
+                }
+            }
+            return Path();
+        }
+
+    public:
+        /**
+         * The position of an iterator: its path (empty at the end).
+         */
+        struct Cursor{
+            Path path;
+
+            Cursor() = default;
+
+            explicit Cursor(const Path& path) : path(path) {
+            }
+
+            bool isEnd() const {
+                return path.empty();
+            }
+
+            const Type& get() const {
+                return path.back()->data;
+            }
+
+            void next() {
+                advance(path);
+            }
+
+            bool operator==(const Cursor& rhs) const {
+                return path.back() == rhs.path.back();
+            }
+        };
+
+        typedef MtmSetIterator<Type, Cursor, false> iterator;
+        typedef MtmSetIterator<Type, Cursor, true> const_iterator;
+
+        /**
+         * Empty constructor
+         * Creates an empty set
+         */
+        MtmPersistentSet() = default;
+
+        /**
+         * Bulk constructor. Creates a set of all the elements in a range,
+         * e.g. a snapshot of an MtmSet.
+         * @tparam InputIterator An iterator that supports ++, * and !=
+         *  (e.g. an iterator of MtmSet).
+         * @param first An iterator to the first element in the range.
+         * @param last An iterator past the last element in the range.
+         */
+        template<typename InputIterator>
+        MtmPersistentSet(InputIterator first, InputIterator last) {
+            for ( ; first != last; ++first) insert(*first);
+        }
+
+        /**
+         * Insert a new element to the set, doesn't insert if there is already
+         *  an equal element in the set.
+         * Copies of the set don't change.
+         * @param elem The element to insert to the set
+         * @return An iterator to the inserted element, or to the equal
+         * element if the element wasn't inserted.
+         */
+        iterator insert(const Type& elem){
+            root = insertInto(root, elem);
+            return iterator(Cursor(pathTo(elem)));
+        }
+
+        /**
+         * Remove an element from the set. If there is no element equal to
+         *  elem in the set, does nothing.
+         * Copies of the set don't change.
+         * @param elem the element to remove.
+         */
+        void erase(const Type& elem){
+            root = eraseFrom(root, elem);
+        }
+
+        /**
+         * Remove the element the iterator points to from the set.
+         * @param it The iterator to the element to the set.
+         * @throws NodeIsEndException if the iterator is end().
+         */
+        void erase(const iterator& it){
+            root = eraseFrom(root, *it);
+        }
+
+        /**
+         * Get the amount of elements in the set.
+         * @return The amount of elements in the set.
+         */
+        int size() const{
+            return countOf(root);
+        }
+
+        /**
+         * Check if the set is empty.
+         * @return true is the set is empty.
+         */
+        bool empty() const{
+            return !root;
+        }
+
+        /**
+         * Empty the set. Nodes shared with copies of the set are kept by the
+         *  copies, the rest are freed.
+         */
+        void clear(){
+            root.reset();
+        }
+
+        /**
+         * Get an iterator to the smallest element in the set.
+         * If set is empty, return the same as end.
+         */
+        iterator begin(){
+            return iterator(Cursor(firstPath()));
+        }
+
+        /**
+         * Get a const_iterator to the smallest element in the set.
+         * If set is empty, return the same as end.
+         */
+        const_iterator begin() const{
+            return const_iterator(Cursor(firstPath()));
+        }
+
+        /**
+         * Returns an iterator referring to the past-the-end element in the set.
+         * @return Iterator to past-the-end element.
+         */
+        iterator end(){
+            return iterator();
+        }
+
+        /**
+         * Returns a const_iterator referring to the past-the-end element in
+         * the set.
+         * @return const_iterator to past-the-end element.
+         */
+        const_iterator end() const{
+            return const_iterator();
+        }
+
+        /**
+         * Find an element in the set.
+         * @param elem The element to find
+         * @return An iterator that points to the elem, or end() if the
+         *  element isn't in the set.
+         */
+        iterator find(const Type& elem){
+            return iterator(Cursor(pathTo(elem)));
+        }
+
+        /**
+         * Find an element in the set.
+         * @param elem The element to find
+         * @return A const_iterator that points to the elem, or end() if the
+         *  element isn't in the set.
+         */
+        const_iterator find(const Type& elem) const{
+            return const_iterator(Cursor(pathTo(elem)));
+        }
+
+        /**
+         * Check if an element is in the set.
+         * @param elem The element to check if it's in the set.
+         * @return True if the element is in the set, false otherwise.
+         */
+        bool contains(const Type& elem) const{
+            return findNode(elem) != nullptr;
+        }
+
+        /**
+         * Check if this set is a superset of a given set.
+         * O(1) if the given set is a copy of this set.
+         * @param subset The set to check if it's a subset.
+         * @return True if the given set is a subset of this set.
+         */
+        bool isSuperSetOf(const MtmPersistentSet& subset) const{
+            if (this->root == subset.root) return true;
+            if (subset.size() > this->size()) return false;
+            for (const Type& elem : subset) {
+                if (!contains(elem)) return false;
+            }
+            return true;
+        }
+
+        /**
+         * Check if two set are equal, meaning, they contain the same elements.
+         * O(1) if one set is a copy of the other.
+         * @param rhs The set right of the == operator.
+         * @return true if the two set contain the same elements, false
+         *  otherwise.
+         */
+        bool operator==(const MtmPersistentSet& rhs) const{
+            if (this->root == rhs.root) return true;
+            if (this->size() != rhs.size()) return false;
+            const_iterator other = rhs.begin();
+            for (const Type& elem : *this) {
+                if (compare(elem, *other) || compare(*other, elem)) {
+                    return false;
+                }
+                ++other;
+            }
+            return true;
+        }
+
+        /**
+         * Check if two set are equal, meaning, they contain the same elements.
+         * @param rhs The set right of the != operator.
+         * @return false if the two set contain the same elements, true
+         *  otherwise.
+         */
+        bool operator!=(const MtmPersistentSet& rhs) const{
+            return !(*this == rhs);
+        }
+
+        /**
+         * Insert all the elements in the given set to this set (union).
+         * If this set is empty, it becomes a copy of the given set in O(1).
+         * @param set The set to insert all the elements from.
+         * @return A reference to this set.
+         */
+        MtmPersistentSet& unite(const MtmPersistentSet& set){
+            if (!this->root) {
+                this->root = set.root;
+                return *this;
+            }
+            for (const Type& elem : set) root = insertInto(root, elem);
+            return *this;
+        }
+
+        /**
+         * Returns a new set that is an union of this set, and a given set.
+         * @param set The other set (other than this) to be in the union.
+         * @return The new set.
+         */
+        MtmPersistentSet unite(const MtmPersistentSet& set) const{
+            MtmPersistentSet united(*this);
+            united.unite(set);
+            return united;
+        }
+
+        /**
+         * Remove all the elements from this set, that are not in the given set
+         * (intersection).
+         * @param set The other set in the intersection.
+         * @return A reference to this set.
+         */
+        MtmPersistentSet& intersect(const MtmPersistentSet& set){
+            if (this->root == set.root) return *this;
+            keepIf([&set](const Type& elem) { return set.contains(elem); });
+            return *this;
+        }
+
+        /**
+         * Returns a new set that is an intersection of this set,
+         *  and a given set.
+         * @param set The other set (other than this) to be in the intersection.
+         * @return The new set.
+         */
+        MtmPersistentSet intersect(const MtmPersistentSet& set) const{
+            MtmPersistentSet intersected(*this);
+            intersected.intersect(set);
+            return intersected;
+        }
+
+        /**
+         * Remove all the elements in the set, that doesn't meet a given
+         *  condition.
+         * @tparam func - A function of an object-function that receive 1
+         *  argument, of the same type as an element in the set, and returns
+         *  a bool.
+         * @param condition - function (or object-function) that returns true
+         * if the element is meeting the condition and false otherwise.
+         * @return A reference to this set.
+         */
+        template<typename func>
+        MtmPersistentSet& getSubSet(func condition){
+            keepIf(condition);
+            return *this;
+        }
+
+        /**
+         * Get a subset of this set, that contains all the elements in the set,
+         * that meet a given condition.
+         * @tparam func - A function of an object-function that receive 1
+         *  argument, of the same type as an element in the set, and returns
+         *  a bool.
+         * @param condition - function (or object-function) that returns true
+         * if the element is meeting the condition and false otherwise.
+         * @return A the new set.
+         */
+        template<typename func>
+        MtmPersistentSet getSubSet(func condition) const{
+            MtmPersistentSet subset(*this);
+            subset.keepIf(condition);
+            return subset;
+        }
+    };
+} // namespace mtm
+
+#endif //MTM4_PERSISTENT_SET_H
@@ -1,17 +1,71 @@
 #ifndef MTM4_SET_H
 #define MTM4_SET_H
 
+#include <cstddef>
+#include <type_traits>
+#include <utility>
 #include "exceptions.h"
+#include "MtmNodePool.h"
 
 namespace mtm{
+    /**
+     * Iteration policy of MtmSet: dereferencing or incrementing an iterator
+     * that doesn't point to an element throws NodeIsEndException.
+     */
+    struct MtmCheckedIteration{
+        static void check(const void* node) {
+            if (!node) throw NodeIsEndException();
+        }
+    };
+
+    /**
+     * Iteration policy of MtmSet: iterators are not checked, so their
+     * operators have no branch and inline to a plain pointer walk.
+     * Dereferencing or incrementing end() is undefined behavior.
+     */
+    struct MtmUncheckedIteration{
+        static void check(const void*) {
+        }
+    };
+
+    /**
+     * The iteration policy of MtmSet when none is given. Building with
+     * MTM_SET_UNCHECKED_ITERATORS defined makes it unchecked, for release
+     * builds.
+     */
+#ifdef MTM_SET_UNCHECKED_ITERATORS
+    typedef MtmUncheckedIteration MtmDefaultIteration;
+#else
+    typedef MtmCheckedIteration MtmDefaultIteration;
+#endif
+
+    /**
+     * Appends elements to a set without checking that they are not already
+     * in it. Only for bulk algorithms that checked the elements themselves
+     * (see MtmParallel.h).
+     */
+    template<typename Set>
+    class MtmSetAppender;
+
     /**
      * A set
      * @tparam Type The type of an element on the group.
      *      Required to implement:
      *                             - operator ==
      *                             - copy constructor
+     *      Elements inserted as rvalues are moved into the set, and emplace
+     *      constructs them in place.
+     * @tparam InlineCapacity The amount of elements stored inside the set
+     *  object itself. Only elements beyond that are allocated on the heap,
+     *  so small sets don't allocate at all. Inline nodes can't be handed
+     *  over, so moving a set with InlineCapacity > 0 moves its elements
+     *  one by one.
+     * @tparam Checking The iteration policy: MtmCheckedIteration, or
+     *  MtmUncheckedIteration. The NodeIsEndException of the iterators is
+     *  thrown only by checked iterators.
      */
-    template<typename Type>
+    template<typename Type, std::size_t InlineCapacity = 0,
+            typename Checking = MtmDefaultIteration>
     class MtmSet{
         /**
          * A node in the set
@@ -21,11 +75,24 @@ namespace mtm{
             Type element;
 
         public:
+            /**
+             * Tag for constructing the element from its constructor's
+             * arguments.
+             */
+            struct InPlace{};
+
             Node() = default;
             explicit Node(Type& element) : next(nullptr), element(element) {
             }
             explicit Node(const Type& element) : next(nullptr), element(element) {
             }
+            explicit Node(Type&& element) : next(nullptr),
+                                            element(std::move(element)) {
+            }
+            template<typename... Args>
+            explicit Node(InPlace, Args&&... args)
+                    : next(nullptr), element(std::forward<Args>(args)...) {
+            }
             Node(const Node& other) : next(nullptr), element(other.element) {
             }
             ~Node() = default;
@@ -53,9 +120,11 @@ namespace mtm{
 
         /**
          * Properties of class MtmSet
+         * pool - Where the nodes of the set are created.
          */
         int set_size;
         Node* head;
+        MtmNodePool<Node, InlineCapacity> pool;
 
         /**
          * Deletes first node of the set, and updates head to the next node.
@@ -63,10 +132,130 @@ namespace mtm{
         void deleteHead() {
             if (!head) return;
             Node* new_head = head->getNext();
-            delete head;
+            pool.destroy(head);
             head = new_head;
             --set_size;
         }
+
+        /**
+         * Find the node of an element equal to elem, or the last node.
+         * @param elem The element to find.
+         * @param found Set to true if an equal element is in the set, and
+         *  to false otherwise.
+         * @return The node of the equal element if found, otherwise the last
+         *  node in the set (nullptr if the set is empty).
+         */
+        Node* findOrLast(const Type& elem, bool& found) const {
+            found = false;
+            Node* current = head;
+            for ( ; current; current = current->getNext()) {
+                if (current->getElement() == elem) {
+                    found = true;
+                    return current;
+                }
+                if (!current->getNext()) return current;
+            }
+            return nullptr;
+        }
+
+        /**
+         * Link a new node at the end of the set.
+         * @param last The last node in the set (nullptr if the set is empty).
+         * @param new_node The node to add.
+         * @return The new node.
+         */
+        Node* append(Node* last, Node* new_node) {
+            if (last) {
+                last->setNext(new_node);
+            } else {
+                head = new_node;
+            }
+            ++set_size;
+            return new_node;
+        }
+
+        /**
+         * Take all the nodes of a given set, into this (empty) set. The given
+         * set becomes empty.
+         * Without inline nodes, the pools are exchanged as a whole.
+         */
+        void takeNodes(MtmSet& set, std::true_type) {
+            std::swap(this->set_size, set.set_size);
+            std::swap(this->head, set.head);
+            this->pool.swap(set.pool);
+        }
+
+        /**
+         * Take all the elements of a given set, into this (empty) set. The
+         * given set becomes empty.
+         * Inline nodes stay with their set, so the elements are moved into
+         * new nodes.
+         */
+        void takeNodes(MtmSet& set, std::false_type) {
+            pool.reserve(std::size_t(set.set_size));
+            Node* last = nullptr;
+            for (Node* current = set.head; current;
+                 current = current->getNext()) {
+                last = append(last,
+                              pool.create(std::move(current->getElement())));
+            }
+            set.clear();
+        }
+
+        /**
+         * Take all the contents of a given set into this (empty) set.
+         */
+        void takeNodes(MtmSet& set) {
+            takeNodes(set, std::integral_constant<bool,
+                    InlineCapacity == 0>());
+        }
+
+        /**
+         * Copy all the nodes of a given set to the end of this (empty) set.
+         * All the new nodes are taken from a single allocation.
+         */
+        void copyNodes(const MtmSet& set) {
+            pool.reserve(std::size_t(set.set_size));
+            Node* current = nullptr;
+            for (Node* original = set.head; original;
+                 original = original->getNext()) {
+                Node* new_node = pool.create(*original);
+                if (current) {
+                    current = current->setNext(new_node);
+                } else {
+                    head = current = new_node;
+                }
+                ++set_size;
+            }
+        }
+
+        /**
+         * Remove all the elements that meet a given condition, in a single
+         * pass over the set. The condition is called once per element, in
+         * the order of the set.
+         */
+        template<typename func>
+        void removeIf(func should_remove) {
+            Node* previous = nullptr;
+            Node* current = head;
+            while (current) {
+                Node* next = current->getNext();
+                if (should_remove(current->getElement())) {
+                    if (previous) {
+                        previous->setNext(next);
+                    } else {
+                        head = next;
+                    }
+                    pool.destroy(current);
+                    --set_size;
+                } else {
+                    previous = current;
+                }
+                current = next;
+            }
+        }
+
+        friend class MtmSetAppender<MtmSet>;
     
     public:
         //Forward declaration
@@ -124,7 +313,7 @@ namespace mtm{
              * an element in the set (end())
              */
             const Type& operator*() const{
-                if (!node) throw NodeIsEndException();
+                Checking::check(node);
                 return node->getElement();
             }
             
@@ -139,7 +328,7 @@ namespace mtm{
              * an element in the set (end())
              */
             const Type *operator->() const{
-                if (!node) throw NodeIsEndException();
+                Checking::check(node);
                 return &node->getElement();
             }
             
@@ -150,7 +339,7 @@ namespace mtm{
              * an element in the set (end())
              */
             iterator& operator++(){
-                if (!node) throw NodeIsEndException();
+                Checking::check(node);
                 node = node->getNext();
                 return *this;
             }
@@ -163,7 +352,7 @@ namespace mtm{
              * an element in the set (end())
              */
             iterator operator++(int){
-                if (!node) throw NodeIsEndException();
+                Checking::check(node);
                 iterator old(*this);
                 node = node->getNext();
                 return old;
@@ -255,7 +444,7 @@ namespace mtm{
              * an element in the set (end())
              */
             const Type& operator*() const{
-                if (!node) throw NodeIsEndException();
+                Checking::check(node);
                 return node->getElement();
             }
             
@@ -270,7 +459,7 @@ namespace mtm{
              * an element in the set (end())
              */
             const Type *operator->() const{
-                if (!node) throw NodeIsEndException();
+                Checking::check(node);
                 return &node->getElement();
             }
             
@@ -281,7 +470,7 @@ namespace mtm{
              * an element in the set (end())
              */
             const_iterator& operator++(){
-                if (!node) throw NodeIsEndException();
+                Checking::check(node);
                 node = node->getNext();
                 return *this;
             }
@@ -294,7 +483,7 @@ namespace mtm{
              * an element in the set (end())
              */
             const_iterator operator++(int){
-                if (!node) throw NodeIsEndException();
+                Checking::check(node);
                 const_iterator old(*this);
                 node = node->getNext();
                 return old;
@@ -331,18 +520,24 @@ namespace mtm{
          * Copy constructor
          * @param set the Set to copy
          */
-        MtmSet(const MtmSet& set) : set_size(set.set_size), head(nullptr) {
-            Node* original = set.head;
-            if (!original) return;
-            this->head = new Node(*original);
-            Node* current = this->head;
-            original = original->getNext();
-            for ( ; original; original = original->getNext()) {
-                Node* new_node = new Node(*original);
-                current = current->setNext(new_node);
+        MtmSet(const MtmSet& set) : set_size(0), head(nullptr) {
+            try {
+                copyNodes(set);
+            } catch (...) {
+                clear();
+                throw;
             }
         }
         
+        /**
+         * Move constructor
+         * Takes the nodes of a given set, which becomes empty.
+         * @param set the Set to move from
+         */
+        MtmSet(MtmSet&& set) : set_size(0), head(nullptr) {
+            this->takeNodes(set);
+        }
+
         /**
          * Destructor
          * Free all allocated memory in the set.
@@ -360,20 +555,47 @@ namespace mtm{
          * element if the element wasn't inserted.
          */
         iterator insert(const Type& elem){
-            if (!head) {
-                head = new Node(elem);
-                set_size = 1;
-                return iterator(head);
-            }
-            Node* current = head;
-            for ( ; current->getNext(); current = current->getNext()) {
-                if (current->getElement() == elem) return iterator(current);
-            }
-            if (current->getElement() == elem) return iterator(current);
-            Node* new_node = new Node(elem);
-            current = current->setNext(new_node);
-            ++set_size;
-            return iterator(current);
+            bool found = false;
+            Node* node = findOrLast(elem, found);
+            if (found) return iterator(node);
+            return iterator(append(node, pool.create(elem)));
+        }
+
+        /**
+         * Insert a new element to the set by moving it, doesn't insert (nor
+         *  move) if there is already an equal element in the set.
+         * If an element was't inserted, all iterators should stay valid.
+         * @param elem The element to insert to the set
+         * @return An iterator to the inserted element, or to the equal
+         * element if the element wasn't inserted.
+         */
+        iterator insert(Type&& elem){
+            bool found = false;
+            Node* node = findOrLast(elem, found);
+            if (found) return iterator(node);
+            return iterator(append(node, pool.create(std::move(elem))));
+        }
+
+        /**
+         * Construct a new element in the set, from the arguments of its
+         *  constructor. If there is already an equal element in the set, the
+         *  new element is destroyed.
+         * If an element was't inserted, all iterators should stay valid.
+         * @param args The arguments for the constructor of the element.
+         * @return An iterator to the inserted element, or to the equal
+         * element if the element wasn't inserted.
+         */
+        template<typename... Args>
+        iterator emplace(Args&&... args){
+            Node* new_node = pool.create(typename Node::InPlace(),
+                                         std::forward<Args>(args)...);
+            bool found = false;
+            Node* node = findOrLast(new_node->getElement(), found);
+            if (found) {
+                pool.destroy(new_node);
+                return iterator(node);
+            }
+            return iterator(append(node, new_node));
         }
         
         /**
@@ -392,7 +614,7 @@ namespace mtm{
             for ( ; current && current->getNext(); current = current->getNext()) {
                 if (current->getNext()->getElement() == elem) {
                     Node* next_next = current->getNext()->getNext();
-                    delete current->getNext();
+                    pool.destroy(current->getNext());
                     current->setNext(next_next);
                     --set_size;
                     return;
@@ -427,9 +649,16 @@ namespace mtm{
         
         /**
          * Empty the set, free all allocated memory in the set.
+         * The nodes are released together with their chunks, so if the
+         * elements don't need a destructor, no node is visited.
          */
         void clear(){
-            while (head) deleteHead();
+            if (!std::is_trivially_destructible<Type>::value) {
+                while (head) deleteHead();
+            }
+            head = nullptr;
+            set_size = 0;
+            pool.release();
         }
         
         /**
@@ -557,7 +786,7 @@ namespace mtm{
          * @param set The set to insert all the elements from.
          * @return A reference to this set.
          */
-        MtmSet& unite(const MtmSet& set){
+        MtmSet& unite(const MtmSet& set) &{
             Node* current = set.head;
             for ( ; current; current = current->getNext()) {
                 this->insert(current->getElement());
@@ -570,10 +799,21 @@ namespace mtm{
          * @param set The other set (other than this) to be in the union.
          * @return The new set.
          */
-        MtmSet unite(const MtmSet& set) const{
+        MtmSet unite(const MtmSet& set) const &{
             MtmSet copied_set(*this);
-            MtmSet& united = copied_set.unite(set);
-            return united;
+            copied_set.unite(set);
+            return copied_set;
+        }
+
+        /**
+         * Union of a temporary set with a given set. The temporary's nodes
+         *  are reused for the result, nothing of it is copied.
+         * @param set The other set to be in the union.
+         * @return The new set.
+         */
+        MtmSet unite(const MtmSet& set) &&{
+            this->unite(set);
+            return std::move(*this);
         }
         
         /**
@@ -582,13 +822,9 @@ namespace mtm{
          * @param set The other set in the intersection.
          * @return A reference to this set.
          */
-        MtmSet& intersect(const MtmSet& set){
-            Node* current = this->head;
-            while (current) {
-                Type& elem = current->getElement();
-                current = current->getNext();
-                if (!set.contains(elem)) this->erase(elem);
-            }
+        MtmSet& intersect(const MtmSet& set) &{
+            if (this == &set) return *this;
+            removeIf([&set](const Type& elem) { return !set.contains(elem); });
             return *this;
         }
         
@@ -598,10 +834,21 @@ namespace mtm{
          * @param set The other set (other than this) to be in the intersection.
          * @return The new set.
          */
-        MtmSet intersect(const MtmSet& set) const{
+        MtmSet intersect(const MtmSet& set) const &{
             MtmSet copied(*this);
-            MtmSet& intersected = copied.intersect(set);
-            return intersected;
+            copied.intersect(set);
+            return copied;
+        }
+
+        /**
+         * Intersection of a temporary set with a given set. The temporary's
+         *  nodes are reused for the result, nothing of it is copied.
+         * @param set The other set in the intersection.
+         * @return The new set.
+         */
+        MtmSet intersect(const MtmSet& set) &&{
+            this->intersect(set);
+            return std::move(*this);
         }
         
         /**
@@ -615,29 +862,42 @@ namespace mtm{
          * @return A reference to this set.
          */
         template<typename func>
-        MtmSet& getSubSet(func condition){
-            Node* current = this->head;
-            while (current) {
-                Type& elem = current->getElement();
-                current = current->getNext();
-                if (!condition(elem)) this->erase(elem);
-            }
+        MtmSet& getSubSet(func condition) &{
+            removeIf([&condition](const Type& elem) {
+                return !condition(elem);
+            });
             return *this;
         }
 
+        /**
+         * Copy assignment operator.
+         * @param set The set to copy.
+         * @return A reference to this set.
+         */
         MtmSet& operator=(const MtmSet& set) {
-            Node* original = set.head;
+            if (this == &set) return *this;
             this->clear();
-            if (!original) return *this;
-            this->head = new Node(*original);
-            Node* current = this->head;
-            original = original->getNext();
-            for ( ; original; original = original->getNext()) {
-                Node* new_node = new Node(*original);
-                current = current->setNext(new_node);
+            try {
+                copyNodes(set);
+            } catch (...) {
+                clear();
+                throw;
             }
             return *this;
         }
+
+        /**
+         * Move assignment operator.
+         * Takes the nodes of a given set, which becomes empty.
+         * @param set The set to move from.
+         * @return A reference to this set.
+         */
+        MtmSet& operator=(MtmSet&& set) {
+            if (this == &set) return *this;
+            this->clear();
+            this->takeNodes(set);
+            return *this;
+        }
         
         /**
          * Get a subset of this set, that contains all the elements in the set,
@@ -650,11 +910,63 @@ namespace mtm{
          * @return A the new set.
          */
         template<typename func>
-        MtmSet getSubSet(func condition) const{
+        MtmSet getSubSet(func condition) const &{
             MtmSet copied(*this);
             copied.getSubSet(condition);
             return copied;
         }
+
+        /**
+         * Get a subset of a temporary set, that contains all the elements
+         * that meet a given condition. The temporary's nodes are reused for
+         * the result, nothing of it is copied.
+         * @tparam func - A function of an object-function that receive 1
+         *  argument, of the same type as an element in the set, and returns
+         *  a bool.
+         * @param condition - function (or object-function) that returns true
+         * if the element is meeting the condition and false otherwise.
+         * @return A the new set.
+         */
+        template<typename func>
+        MtmSet getSubSet(func condition) &&{
+            this->getSubSet(condition);
+            return std::move(*this);
+        }
+    };
+
+    template<typename Type, std::size_t InlineCapacity, typename Checking>
+    class MtmSetAppender<MtmSet<Type, InlineCapacity, Checking> >{
+        typedef MtmSet<Type, InlineCapacity, Checking> Set;
+        typedef typename Set::Node Node;
+
+        Set& set;
+        Node* last;
+
+    public:
+        /**
+         * Constructor of MtmSetAppender
+         * @param set The set to append to. Takes time proportional to its
+         *  size, to find its end.
+         */
+        explicit MtmSetAppender(Set& set) : set(set), last(set.head) {
+            while (last && last->getNext()) last = last->getNext();
+        }
+
+        /**
+         * Make sure the next element_count appends allocate at most once.
+         */
+        void reserve(std::size_t element_count) {
+            set.pool.reserve(element_count);
+        }
+
+        /**
+         * Append an element to the end of the set, in O(1).
+         * @param elem The element. Must not be equal to any element in the
+         *  set.
+         */
+        void append(const Type& elem) {
+            last = set.append(last, set.pool.create(elem));
+        }
     };
 } // namespace mtm
 
@@ -0,0 +1,177 @@
+#ifndef MTM4_SET_ITERATOR_H
+#define MTM4_SET_ITERATOR_H
+
+#include <type_traits>
+#include <utility>
+#include "exceptions.h"
+
+namespace mtm{
+    /**
+     * The iterator and const_iterator of the sets with the interface of
+     * MtmSet that keep their elements in other structures (MtmHashSet,
+     * MtmFlatSet, MtmBitSet and MtmPersistentSet). Like the iterators of
+     * MtmSet, neither can change an element, operating on an iterator that
+     * doesn't point to an element throws NodeIsEndException, and all such
+     * iterators are equal.
+     * The set supplies the Cursor, the position of the iterator in it:
+     *  - A default constructed Cursor is at the end.
+     *  - bool isEnd() const
+     *  - get() const - Only called when not at the end. Returns const
+     *    Type& to an element kept in the set, or a Type by value for a set
+     *    that doesn't keep its elements as objects (MtmBitSet). The
+     *    iterator is then a proxy iterator: operator* returns the Type by
+     *    value too, and operator-> returns an object that holds it.
+     *  - void next() - Only called when not at the end.
+     *  - bool operator==(const Cursor&) const - Only called when neither
+     *    cursor is at the end.
+     * @tparam Type The type of an element on the set.
+     * @tparam Cursor The position in the set.
+     * @tparam IsConst true for const_iterator, false for iterator. An
+     *  iterator converts to a const_iterator.
+     */
+    template<typename Type, typename Cursor, bool IsConst>
+    class MtmSetIterator{
+        Cursor position;
+
+        /**
+         * What operator-> of a proxy iterator returns: a copy of the
+         * element, that lives until the end of the full expression.
+         */
+        struct Arrow{
+            Type value;
+
+            const Type* operator->() const{
+                return &value;
+            }
+        };
+
+        static const Type* arrowTo(const Type& elem, std::true_type){
+            return &elem;
+        }
+
+        static Arrow arrowTo(const Type& elem, std::false_type){
+            Arrow arrow = {elem};
+            return arrow;
+        }
+
+    public:
+        /**
+         * What operator* returns: const Type&, or Type for a proxy
+         * iterator.
+         */
+        typedef decltype(std::declval<const Cursor&>().get()) reference;
+
+        /**
+         * What operator-> returns: const Type*, or an object with its own
+         * operator-> for a proxy iterator.
+         */
+        typedef typename std::conditional<std::is_reference<reference>::value,
+                const Type*, Arrow>::type pointer;
+
+        /**
+         * Empty constructor. Should not be dereferenced.
+         * Same as end() of the set.
+         */
+        MtmSetIterator() = default;
+
+        /**
+         * Constructor of an iterator at a given position.
+         * @param position The position of the iterator in the set.
+         */
+        explicit MtmSetIterator(const Cursor& position) : position(position) {
+        }
+
+        /**
+         * Constructor of a const_iterator from an iterator.
+         * @param it The iterator to "copy" to a const_iterator
+         */
+        template<bool OtherConst, bool Enable = IsConst && !OtherConst,
+                typename = typename std::enable_if<Enable>::type>
+        MtmSetIterator(const MtmSetIterator<Type, Cursor, OtherConst>& it)
+                : position(it.cursor()) {
+        }
+
+        /**
+         * @return The position of the iterator, for the set it is on.
+         */
+        const Cursor& cursor() const{
+            return position;
+        }
+
+        /**
+         * Dereference operator * .
+         * @return A reference of the element the iterator points to (or a
+         *  copy of it, for a proxy iterator).
+         * @throws NodeIsEndException if the iterator doesn't point to
+         * an element in the set (end())
+         */
+        reference operator*() const{
+            if (position.isEnd()) throw NodeIsEndException();
+            return position.get();
+        }
+
+        /**
+         * Dereference operator -> .
+         * @return A pointer to the element the iterator points to (or an
+         *  object that holds a copy of it, for a proxy iterator).
+         * @throws NodeIsEndException if the iterator doesn't point to
+         * an element in the set (end())
+         */
+        pointer operator->() const{
+            return arrowTo(**this, std::is_reference<reference>());
+        }
+
+        /**
+         * Prefix increment operator (++i)
+         * @return a reference to the iterator;
+         * @throws NodeIsEndException if the iterator doesn't point to
+         * an element in the set (end())
+         */
+        MtmSetIterator& operator++(){
+            if (position.isEnd()) throw NodeIsEndException();
+            position.next();
+            return *this;
+        }
+
+        /**
+         * Postfix increment operator (i++)
+         * @return An iterator that points to the same element as this
+         *  before the increment
+         * @throws NodeIsEndException if the iterator doesn't point to
+         * an element in the set (end())
+         */
+        MtmSetIterator operator++(int){
+            MtmSetIterator old(*this);
+            ++*this;
+            return old;
+        }
+
+        /**
+         * Compare with an iterator or a const_iterator.
+         * All the iterators that don't point to an element are equal.
+         * @param rhs the right iterator
+         * @return true if the two iterators point to the same element
+         */
+        template<bool OtherConst>
+        bool operator==(const MtmSetIterator<Type, Cursor, OtherConst>& rhs)
+                const{
+            if (position.isEnd() || rhs.cursor().isEnd()) {
+                return position.isEnd() && rhs.cursor().isEnd();
+            }
+            return position == rhs.cursor();
+        }
+
+        /**
+         * Compare with an iterator or a const_iterator.
+         * @param rhs the right iterator
+         * @return true if the two iterators don't point to the same element
+         */
+        template<bool OtherConst>
+        bool operator!=(const MtmSetIterator<Type, Cursor, OtherConst>& rhs)
+                const{
+            return !(*this == rhs);
+        }
+    };
+} // namespace mtm
+
+#endif //MTM4_SET_ITERATOR_H
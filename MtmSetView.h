@@ -0,0 +1,443 @@
+#ifndef MTM4_SET_VIEW_H
+#define MTM4_SET_VIEW_H
+
+#include <type_traits>
+#include <utility>
+#include "MtmSet.h"
+
+namespace mtm{
+    /**
+     * Lazy set expressions.
+     * view(set) wraps a set (MtmSet, MtmHashSet, MtmFlatSet or any class
+     * with begin(), end() and contains()) without copying it. On a view,
+     * unite, intersect and getSubSet don't build a new set: they return a
+     * new view that combines its operands when it is iterated or asked
+     * contains(), and the views compose:
+     *
+     *      for (const string& name : view(a).unite(b).getSubSet(pred)) ...
+     *
+     * walks a and b once, and allocates nothing. materialize() builds a set
+     * from a view when one is needed.
+     * A view only refers to the sets it was built from, so it must not be
+     * used after they are destroyed, and its iterators are invalidated by
+     * any change to them.
+     */
+
+    /**
+     * Base of all the view classes, used to tell views from sets.
+     */
+    struct MtmSetViewTag{
+    };
+
+    template<typename Set>
+    class MtmSetRef;
+
+    /**
+     * The view type of a unite/intersect operand: a view is used as is,
+     * a set is wrapped in an MtmSetRef.
+     */
+    template<typename Operand,
+            bool IsView = std::is_base_of<MtmSetViewTag, Operand>::value>
+    struct MtmViewOf{
+        typedef MtmSetRef<Operand> type;
+
+        static type make(const Operand& set) {
+            return type(set);
+        }
+    };
+
+    template<typename Operand>
+    struct MtmViewOf<Operand, true>{
+        typedef Operand type;
+
+        static const Operand& make(const Operand& view) {
+            return view;
+        }
+    };
+
+    /**
+     * An iterator over the elements of another iterator's range, that
+     * skips the elements that don't meet a condition.
+     */
+    template<typename Inner, typename Predicate>
+    class MtmFilterIterator{
+        Inner current;
+        Inner last;
+        Predicate condition;
+
+        void skip() {
+            while (current != last && !condition(*current)) ++current;
+        }
+
+    public:
+        MtmFilterIterator(const Inner& first, const Inner& last,
+                          const Predicate& condition)
+                : current(first), last(last), condition(condition) {
+            skip();
+        }
+
+        /**
+         * @throws NodeIsEndException if the iterator is at the end.
+         */
+        auto operator*() const -> decltype(*current) {
+            return *current;
+        }
+
+        template<typename It = Inner>
+        auto operator->() const
+                -> decltype(std::declval<const It&>().operator->()) {
+            return current.operator->();
+        }
+
+        /**
+         * @throws NodeIsEndException if the iterator is at the end.
+         */
+        MtmFilterIterator& operator++() {
+            ++current;
+            skip();
+            return *this;
+        }
+
+        MtmFilterIterator operator++(int) {
+            MtmFilterIterator old(*this);
+            ++*this;
+            return old;
+        }
+
+        bool operator==(const MtmFilterIterator& rhs) const {
+            return current == rhs.current;
+        }
+
+        bool operator!=(const MtmFilterIterator& rhs) const {
+            return !(*this == rhs);
+        }
+    };
+
+    /**
+     * An iterator over one range, followed by a second range.
+     */
+    template<typename First, typename Second>
+    class MtmChainIterator{
+        First first;
+        First first_last;
+        Second second;
+
+    public:
+        MtmChainIterator(const First& first, const First& first_last,
+                         const Second& second)
+                : first(first), first_last(first_last), second(second) {
+        }
+
+        /**
+         * @throws NodeIsEndException if the iterator is at the end.
+         */
+        auto operator*() const -> decltype(*second) {
+            if (first != first_last) return *first;
+            return *second;
+        }
+
+        /**
+         * Only for iterators that return references (not proxy iterators).
+         */
+        template<typename It = Second>
+        auto operator->() const -> decltype(&*std::declval<const It&>()) {
+            return &**this;
+        }
+
+        /**
+         * @throws NodeIsEndException if the iterator is at the end.
+         */
+        MtmChainIterator& operator++() {
+            if (first != first_last) {
+                ++first;
+            } else {
+                ++second;
+            }
+            return *this;
+        }
+
+        MtmChainIterator operator++(int) {
+            MtmChainIterator old(*this);
+            ++*this;
+            return old;
+        }
+
+        bool operator==(const MtmChainIterator& rhs) const {
+            return first == rhs.first && second == rhs.second;
+        }
+
+        bool operator!=(const MtmChainIterator& rhs) const {
+            return !(*this == rhs);
+        }
+    };
+
+    template<typename Left, typename Right>
+    class MtmUnionView;
+
+    template<typename Inner, typename Predicate>
+    class MtmFilterView;
+
+    /**
+     * A condition that an element is in a given view.
+     */
+    template<typename View>
+    struct MtmContainedIn{
+        const View* view;
+
+        template<typename Type>
+        bool operator()(const Type& elem) const {
+            return view->contains(elem);
+        }
+    };
+
+    /**
+     * A condition that an element is not in a given view.
+     */
+    template<typename View>
+    struct MtmNotContainedIn{
+        const View* view;
+
+        template<typename Type>
+        bool operator()(const Type& elem) const {
+            return !view->contains(elem);
+        }
+    };
+
+    /**
+     * The operations shared by all the views.
+     * @tparam View The view class that inherits this class.
+     */
+    template<typename View>
+    class MtmSetExpression : public MtmSetViewTag{
+        const View& self() const {
+            return static_cast<const View&>(*this);
+        }
+
+    public:
+        /**
+         * Get a view of the union of this view and a given set or view.
+         * Iterates the elements of this view, and then the elements of the
+         * other that are not in this view.
+         * @param other The set or view to unite with.
+         * @return The new view.
+         */
+        template<typename Other>
+        MtmUnionView<View, typename MtmViewOf<Other>::type>
+        unite(const Other& other) const {
+            return MtmUnionView<View, typename MtmViewOf<Other>::type>(
+                    self(), MtmViewOf<Other>::make(other));
+        }
+
+        /**
+         * Get a view of the intersection of this view and a given set or
+         * view.
+         * Iterates the elements of this view that are in the other.
+         * @param other The set or view to intersect with.
+         * @return The new view.
+         */
+        template<typename Other>
+        MtmFilterView<View,
+                MtmContainedIn<typename MtmViewOf<Other>::type> >
+        intersect(const Other& other) const {
+            return MtmFilterView<View,
+                    MtmContainedIn<typename MtmViewOf<Other>::type> >(
+                    self(), MtmViewOf<Other>::make(other));
+        }
+
+        /**
+         * Get a view of the elements of this view that meet a condition.
+         * @tparam func - A function of an object-function that receive 1
+         *  argument, of the same type as an element in the set, and returns
+         *  a bool.
+         * @param condition - function (or object-function) that returns true
+         * if the element is meeting the condition and false otherwise.
+         * @return The new view.
+         */
+        template<typename func>
+        MtmFilterView<View, func> getSubSet(func condition) const {
+            return MtmFilterView<View, func>(self(), condition);
+        }
+
+        /**
+         * Count the elements of the view, by iterating it.
+         * @return The amount of elements in the view.
+         */
+        int size() const {
+            int count = 0;
+            for (auto it = self().begin(); it != self().end(); ++it) ++count;
+            return count;
+        }
+
+        /**
+         * Check if the view is empty. Stops at the first element.
+         * @return true is the view is empty.
+         */
+        bool empty() const {
+            return !(self().begin() != self().end());
+        }
+
+        /**
+         * Build a set of the elements of the view.
+         * @tparam Set The type of the set to build. MtmSet by default.
+         * @return The new set.
+         */
+        template<typename Set = void, typename Self = View>
+        typename std::conditional<std::is_void<Set>::value,
+                MtmSet<typename Self::value_type>, Set>::type
+        materialize() const {
+            typename std::conditional<std::is_void<Set>::value,
+                    MtmSet<typename Self::value_type>, Set>::type set;
+            for (auto it = self().begin(); it != self().end(); ++it) {
+                set.insert(*it);
+            }
+            return set;
+        }
+    };
+
+    /**
+     * A view of an existing set.
+     * @tparam Set The type of the set.
+     */
+    template<typename Set>
+    class MtmSetRef : public MtmSetExpression<MtmSetRef<Set> >{
+        const Set* set;
+
+    public:
+        typedef typename std::decay<decltype(*std::declval<const Set&>()
+                .begin())>::type value_type;
+        typedef decltype(std::declval<const Set&>().begin()) const_iterator;
+
+        explicit MtmSetRef(const Set& set) : set(&set) {
+        }
+
+        const_iterator begin() const {
+            return set->begin();
+        }
+
+        const_iterator end() const {
+            return set->end();
+        }
+
+        bool contains(const value_type& elem) const {
+            return set->contains(elem);
+        }
+    };
+
+    /**
+     * A view of the union of two views.
+     */
+    template<typename Left, typename Right>
+    class MtmUnionView : public MtmSetExpression<MtmUnionView<Left, Right> >{
+        Left left;
+        Right right;
+
+        typedef MtmFilterIterator<typename Right::const_iterator,
+                MtmNotContainedIn<Left> > RightIterator;
+
+    public:
+        typedef typename Left::value_type value_type;
+        typedef MtmChainIterator<typename Left::const_iterator,
+                RightIterator> const_iterator;
+
+        MtmUnionView(const Left& left, const Right& right)
+                : left(left), right(right) {
+        }
+
+        const_iterator begin() const {
+            MtmNotContainedIn<Left> condition = { &left };
+            return const_iterator(left.begin(), left.end(),
+                                  RightIterator(right.begin(), right.end(),
+                                                condition));
+        }
+
+        const_iterator end() const {
+            MtmNotContainedIn<Left> condition = { &left };
+            return const_iterator(left.end(), left.end(),
+                                  RightIterator(right.end(), right.end(),
+                                                condition));
+        }
+
+        bool contains(const value_type& elem) const {
+            return left.contains(elem) || right.contains(elem);
+        }
+    };
+
+    /**
+     * A view of the elements of a view that meet a condition.
+     */
+    template<typename Inner, typename Predicate>
+    class MtmFilterView
+            : public MtmSetExpression<MtmFilterView<Inner, Predicate> >{
+        Inner inner;
+        Predicate condition;
+
+    public:
+        typedef typename Inner::value_type value_type;
+        typedef MtmFilterIterator<typename Inner::const_iterator, Predicate>
+                const_iterator;
+
+        MtmFilterView(const Inner& inner, const Predicate& condition)
+                : inner(inner), condition(condition) {
+        }
+
+        const_iterator begin() const {
+            return const_iterator(inner.begin(), inner.end(), condition);
+        }
+
+        const_iterator end() const {
+            return const_iterator(inner.end(), inner.end(), condition);
+        }
+
+        bool contains(const value_type& elem) const {
+            return inner.contains(elem) && condition(elem);
+        }
+    };
+
+    /**
+     * A view of the elements of another view that are in a third view.
+     * The operand is kept in the view, and the condition points to it when
+     * the view is iterated, so the view can be copied.
+     */
+    template<typename Inner, typename Other>
+    class MtmFilterView<Inner, MtmContainedIn<Other> >
+            : public MtmSetExpression<MtmFilterView<Inner,
+                    MtmContainedIn<Other> > >{
+        Inner inner;
+        Other other;
+
+    public:
+        typedef typename Inner::value_type value_type;
+        typedef MtmFilterIterator<typename Inner::const_iterator,
+                MtmContainedIn<Other> > const_iterator;
+
+        MtmFilterView(const Inner& inner, const Other& other)
+                : inner(inner), other(other) {
+        }
+
+        const_iterator begin() const {
+            MtmContainedIn<Other> condition = { &other };
+            return const_iterator(inner.begin(), inner.end(), condition);
+        }
+
+        const_iterator end() const {
+            MtmContainedIn<Other> condition = { &other };
+            return const_iterator(inner.end(), inner.end(), condition);
+        }
+
+        bool contains(const value_type& elem) const {
+            return inner.contains(elem) && other.contains(elem);
+        }
+    };
+
+    /**
+     * Get a lazy view of a set, to build set expressions on.
+     * @param set The set. Must outlive the view.
+     * @return The view.
+     */
+    template<typename Set>
+    MtmSetRef<Set> view(const Set& set) {
+        return MtmSetRef<Set>(set);
+    }
+} // namespace mtm
+
+#endif //MTM4_SET_VIEW_H
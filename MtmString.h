@@ -0,0 +1,92 @@
+#ifndef MTM4_STRING_H
+#define MTM4_STRING_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+namespace mtm{
+    /**
+     * A reference to characters owned by someone else: a std::string, a
+     * string literal or any other array of chars. Constructing it never
+     * allocates, so it is used to look up strings without building a
+     * std::string.
+     * It must not be used after the characters it refers to are destroyed.
+     */
+    class MtmStringRef{
+        const char* characters;
+        std::size_t length;
+
+    public:
+        MtmStringRef(const char* characters)
+                : characters(characters), length(std::strlen(characters)) {
+        }
+
+        MtmStringRef(const char* characters, std::size_t length)
+                : characters(characters), length(length) {
+        }
+
+        MtmStringRef(const std::string& string)
+                : characters(string.data()), length(string.size()) {
+        }
+
+        const char* data() const {
+            return characters;
+        }
+
+        std::size_t size() const {
+            return length;
+        }
+
+        bool operator==(const MtmStringRef& rhs) const {
+            return length == rhs.length
+                   && std::memcmp(characters, rhs.characters, length) == 0;
+        }
+
+        bool operator!=(const MtmStringRef& rhs) const {
+            return !(*this == rhs);
+        }
+
+        /**
+         * @return A new std::string with a copy of the characters.
+         */
+        std::string str() const {
+            return std::string(characters, length);
+        }
+    };
+
+    /**
+     * A hash for strings, that accepts std::string, const char* and
+     * MtmStringRef alike (and gives the same hash for the same characters),
+     * so a set of std::string can be probed with any of them.
+     * FNV-1a: a multiply and a xor per character, faster than the standard
+     * hash for the short names used as keys.
+     */
+    struct MtmStringHash{
+        typedef void is_transparent;
+
+        std::size_t operator()(MtmStringRef string) const {
+            std::uint64_t hash = 14695981039346656037ULL;
+            for (std::size_t i = 0; i < string.size(); ++i) {
+                hash ^= static_cast<unsigned char>(string.data()[i]);
+                hash *= 1099511628211ULL;
+            }
+            return std::size_t(hash ^ (hash >> 32));
+        }
+    };
+
+    /**
+     * Equality of strings, that accepts std::string, const char* and
+     * MtmStringRef alike. The equality for MtmStringHash.
+     */
+    struct MtmStringEqual{
+        typedef void is_transparent;
+
+        bool operator()(MtmStringRef first, MtmStringRef second) const {
+            return first == second;
+        }
+    };
+} // namespace mtm
+
+#endif //MTM4_STRING_H
@@ -0,0 +1,211 @@
+#include <limits>
+#include "PackedGroup.h"
+#include "GroupRules.h"
+#include "exceptions.h"
+
+namespace mtm {
+
+    /* PackedGroup plays by the rules of Group */
+    typedef GroupEngine<DefaultGroupRules> PackedEngine;
+
+    /**
+     * Class fields:
+     *  SymbolTable::Symbol name, clan;
+     *  std::uint32_t children, adults, tools, food;
+     *  std::uint8_t morale;
+     */
+
+    /**
+     * Check that a result fits in a number of a group (an int, as in Group).
+     * @return The result.
+     * @throws GroupOverflow If it doesn't fit.
+     */
+    static std::uint32_t checked(std::int64_t value) {
+        if (value > std::numeric_limits<int>::max()) throw GroupOverflow();
+        return std::uint32_t(value);
+    }
+
+    PackedGroup::PackedGroup(const Group& group, SymbolTable& table)
+            : name(table.intern(group.getName())),
+              clan(table.intern(group.getClan())),
+              children(group.children), adults(group.adults),
+              tools(group.tools), food(group.food),
+              morale(std::uint8_t(group.morale)) {
+    }
+
+    void PackedGroup::unpackTo(Group& target, SymbolTable& table) const {
+        std::string old_name;
+        if (target.listener) old_name = target.getName();
+        GroupTotals before = target.getTotals();
+        target.name.clear();
+        target.clan.clear();
+        target.symbols = &table;
+        target.name_symbol = this->name;
+        target.clan_symbol = this->clan;
+        target.children = this->getChildren();
+        target.adults = this->getAdults();
+        target.tools = this->getTools();
+        target.food = this->getFood();
+        target.morale = this->getMorale();
+        target.updatePower();
+        target.renamed(old_name);
+        target.changed(before);
+    }
+
+    const std::string& PackedGroup::getName(const SymbolTable& table) const {
+        return table.name(this->name);
+    }
+
+    const std::string& PackedGroup::getClan(const SymbolTable& table) const {
+        return table.name(this->clan);
+    }
+
+    SymbolTable::Symbol PackedGroup::getNameSymbol() const {
+        return this->name;
+    }
+
+    SymbolTable::Symbol PackedGroup::getClanSymbol() const {
+        return this->clan;
+    }
+
+    int PackedGroup::getChildren() const {
+        return int(this->children);
+    }
+
+    int PackedGroup::getAdults() const {
+        return int(this->adults);
+    }
+
+    int PackedGroup::getTools() const {
+        return int(this->tools);
+    }
+
+    int PackedGroup::getFood() const {
+        return int(this->food);
+    }
+
+    int PackedGroup::getMorale() const {
+        return int(this->morale);
+    }
+
+    int PackedGroup::getSize() const {
+        return int(checked(std::int64_t(this->children) + this->adults));
+    }
+
+    std::int64_t PackedGroup::getPower() const {
+        return PackedEngine::power(this->getChildren(), this->getAdults(),
+                                   this->getTools(), this->getFood(),
+                                   this->getMorale());
+    }
+
+    int PackedGroup::compare(const PackedGroup& rhs,
+                             const SymbolTable& table) const {
+        std::int64_t power = this->getPower(), rhs_power = rhs.getPower();
+        if (power != rhs_power) return power < rhs_power ? -1 : 1;
+        if (this->name == rhs.name) return 0;
+        return this->getName(table).compare(rhs.getName(table));
+    }
+
+    void PackedGroup::clear() {
+        this->name = SymbolTable::EMPTY;
+        this->clan = SymbolTable::EMPTY;
+        this->children = 0;
+        this->adults = 0;
+        this->tools = 0;
+        this->food = 0;
+        this->morale = 0;
+    }
+
+    bool PackedGroup::unite(PackedGroup& other, int max_amount) {
+        if (this == &other) return false;
+        std::int64_t size_this = std::int64_t(this->children) + this->adults;
+        std::int64_t size_other = std::int64_t(other.children) + other.adults;
+        if (this->clan != other.clan || size_this + size_other > max_amount
+            || !PackedEngine::canUnite(this->morale, other.morale)) {
+            return false;
+        }
+        /* Everything is computed (and checked) before anything changes */
+        std::uint32_t children = checked(std::int64_t(this->children)
+                                         + other.children);
+        std::uint32_t adults = checked(std::int64_t(this->adults)
+                                       + other.adults);
+        std::uint32_t tools = checked(std::int64_t(this->tools) + other.tools);
+        std::uint32_t food = checked(std::int64_t(this->food) + other.food);
+        std::int64_t morale_total = size_this * this->morale
+                                    + size_other * other.morale;
+        if (this->getPower() < other.getPower()) this->name = other.name;
+        this->children = children;
+        this->adults = adults;
+        this->tools = tools;
+        this->food = food;
+        this->morale = std::uint8_t(morale_total / (size_this + size_other));
+        other.clear();
+        return true;
+    }
+
+    void PackedGroup::handleFight(PackedGroup& loser) {
+        int loser_children = loser.getChildren();
+        int loser_adults = loser.getAdults();
+        int loser_tools = loser.getTools();
+        int loser_food = loser.getFood();
+        int loser_morale = loser.getMorale();
+        int lost_food = PackedEngine::loseFight(loser_children, loser_adults,
+                                                loser_tools, loser_food,
+                                                loser_morale);
+        /* The only number that grows is the food of the winner */
+        checked(std::int64_t(this->food)
+                + lost_food / DefaultGroupRules::DIVISOR_FOOD_FURTHER);
+        int winner_adults = this->getAdults();
+        int winner_tools = this->getTools();
+        int winner_food = this->getFood();
+        int winner_morale = this->getMorale();
+        PackedEngine::winFight(winner_adults, winner_tools, winner_food,
+                               winner_morale, lost_food);
+        loser.children = std::uint32_t(loser_children);
+        loser.adults = std::uint32_t(loser_adults);
+        loser.tools = std::uint32_t(loser_tools);
+        loser.food = std::uint32_t(loser_food);
+        loser.morale = std::uint8_t(loser_morale);
+        this->adults = std::uint32_t(winner_adults);
+        this->tools = std::uint32_t(winner_tools);
+        this->food = std::uint32_t(winner_food);
+        this->morale = std::uint8_t(winner_morale);
+    }
+
+    FIGHT_RESULT PackedGroup::fight(PackedGroup& opponent,
+                                    const SymbolTable& table) {
+        if (this == &opponent) throw GroupCantFightWithItself();
+        if (this->getSize() == 0 || opponent.getSize() == 0) {
+            throw GroupCantFightEmptyGroup();
+        }
+        int order = this->compare(opponent, table);
+        if (order == 0) return DRAW;
+        if (order > 0) {
+            this->handleFight(opponent);
+        } else {
+            opponent.handleFight(*this);
+        }
+        if (this->getPower() == 0) this->clear();
+        if (opponent.getPower() == 0) opponent.clear();
+        return order > 0 ? WON : LOST;
+    }
+
+    bool PackedGroup::trade(PackedGroup& other) {
+        if (this == &other) throw GroupCantTradeWithItself();
+        int amount = PackedEngine::tradeAmount(this->getFood(),
+                                               this->getTools(),
+                                               other.getFood(),
+                                               other.getTools());
+        if (amount == 0) return false;
+        /* Each group gets the resource it has less of */
+        PackedGroup& food_giver = this->food > this->tools ? *this : other;
+        PackedGroup& tools_giver = this->food > this->tools ? other : *this;
+        std::uint32_t tools = checked(std::int64_t(food_giver.tools) + amount);
+        std::uint32_t food = checked(std::int64_t(tools_giver.food) + amount);
+        food_giver.food -= amount;
+        food_giver.tools = tools;
+        tools_giver.tools -= amount;
+        tools_giver.food = food;
+        return true;
+    }
+}
@@ -0,0 +1,136 @@
+#ifndef MTM4_PACKED_GROUP_H
+#define MTM4_PACKED_GROUP_H
+
+#include <cstdint>
+#include <string>
+#include "Group.h"
+#include "SymbolTable.h"
+
+namespace mtm{
+
+    /**
+     * A compact encoding of a Group, for worlds with very many groups.
+     * The name and the clan are symbols of a SymbolTable (that is passed to
+     *  the methods that need the strings, instead of being pointed to), the
+     *  morale, which is between 0 and 100, takes a single byte, and the
+     *  power is computed when needed instead of being stored. The whole
+     *  group takes at most 32 bytes, instead of more than 100 for Group.
+     * The numbers can get as big as they can in Group (the biggest int), and
+     *  every operation checks that its results fit: if one doesn't, the
+     *  operation throws GroupOverflow, and doesn't change any group.
+     * The rules are the rules of Group.
+     */
+    class PackedGroup{
+        SymbolTable::Symbol name, clan;
+        std::uint32_t children, adults, tools, food;
+        std::uint8_t morale;
+
+        /**
+         * Clears the group, like Group::clearGroup: all numbers become 0,
+         *  the name and clan become empty.
+         */
+        void clear();
+
+        /**
+         * Applies the aftermath of a fight. This group is the winner.
+         * @param loser The losing group.
+         * @throws GroupOverflow If the food of the winner doesn't fit.
+         */
+        void handleFight(PackedGroup& loser);
+
+    public:
+        /**
+         * Pack a group.
+         * @param group The group to pack.
+         * @param table The table to intern the name and clan of the group
+         *  in.
+         */
+        PackedGroup(const Group& group, SymbolTable& table);
+
+        /**
+         * Copy the group back to a Group object, interned in the table.
+         * @param target The group to overwrite.
+         * @param table The table the group was packed with.
+         */
+        void unpackTo(Group& target, SymbolTable& table) const;
+
+        /**
+         * @param table The table the group was packed with.
+         * @return The name of the group.
+         */
+        const std::string& getName(const SymbolTable& table) const;
+
+        /**
+         * @param table The table the group was packed with.
+         * @return The name of the clan of the group.
+         */
+        const std::string& getClan(const SymbolTable& table) const;
+
+        SymbolTable::Symbol getNameSymbol() const;
+        SymbolTable::Symbol getClanSymbol() const;
+        int getChildren() const;
+        int getAdults() const;
+        int getTools() const;
+        int getFood() const;
+        int getMorale() const;
+
+        /**
+         * @return The amount of people in the group.
+         */
+        int getSize() const;
+
+        /**
+         * @return 100 times the power of the group, as in Group.
+         */
+        std::int64_t getPower() const;
+
+        /**
+         * Compare two groups, like Group::compare: according to power, and
+         *  name.
+         * @param rhs The group to compare with.
+         * @param table The table the groups were packed with.
+         * @return A negative number if this group is smaller than rhs, 0 if
+         *  they have the same power and name, and a positive number if this
+         *  group is bigger.
+         */
+        int compare(const PackedGroup& rhs, const SymbolTable& table) const;
+
+        /**
+         * Try to unite two groups, like Group::unite.
+         * @param other The group to unite with.
+         * @param max_amount If the two groups have more people combined then
+         *  max_amount, then the union fails.
+         * @return True if Unite was successful, false otherwise.
+         * @throws GroupOverflow If a sum doesn't fit in the group.
+         */
+        bool unite(PackedGroup& other, int max_amount);
+
+        /**
+         * This group fights an opponent group, like Group::fight.
+         * @param opponent The group to fight with.
+         * @param table The table the groups were packed with, to break ties
+         *  in power by name.
+         * @return WON if this group won, LOST if this group lost, and DRAW
+         * in case the 2 groups are equal.
+         * @throws GroupCantFightWithItself if opponent is the same as this
+         * @throws GroupCantFightEmptyGroup if this group, or the other group
+         *  is empty (i.e no people).
+         * @throws GroupOverflow If the food of the winner doesn't fit.
+         */
+        FIGHT_RESULT fight(PackedGroup& opponent, const SymbolTable& table);
+
+        /**
+         * Try to do a trade between the two groups, like Group::trade.
+         * @param other Group to trade with.
+         * @return true if a trade was made, false otherwise.
+         * @throws GroupCantTradeWithItself if other is the same as this
+         * @throws GroupOverflow If the resources a group gets don't fit.
+         */
+        bool trade(PackedGroup& other);
+    };
+
+    static_assert(sizeof(PackedGroup) <= 32,
+                  "PackedGroup must fit in 32 bytes");
+} // namespace mtm
+
+#endif //MTM4_PACKED_GROUP_H
@@ -38,7 +38,7 @@ namespace mtm {
             if (group_size * 3 > clan_size) { /* group size > 1/3 * clan size */
                 if (group_size >= 10) {
                     cstring new_name(generateNewGroupName(group->getName()));
-                    group_clan.addGroup(Group(group->divide(new_name)));
+                    group_clan.addGroup(group->divide(new_name));
                     this->groups.push_back(group_clan.getGroup(new_name));
                 }
                 this->groups.push_back(group);
@@ -47,7 +47,7 @@ namespace mtm {
                 this->sortByStrongest();
                 for (const GroupPointer& current : this->groups) {
                     if (current->getSize() == 0) continue;
-                    if (current->getClan() != clan) continue;
+                    if (!current->hasSameClan(*group)) continue;
                     if (current->unite(*group, clan_size / 3)) {
                         success = true;
                         break;
@@ -23,11 +23,13 @@ namespace mtm {
             Clan& group_clan = getNewGroupClan(group_name, clan, clan_map);
             const GroupPointer& group = group_clan.getGroup(group_name);
             this->sortByStrongest();
+
+            /* The friendly groups are tried strongest first. Group::trade
+             * decides by GroupEngine::tradeAmount, and changes neither group
+             * when they don't trade */
             for (const GroupPointer& current : this->groups) {
                 if (current->getSize() == 0) continue;
-                if (!group_clan.isFriend(clan_map.at(current->getClan()))) {
-                    continue;
-                }
+                if (!group_clan.isFriend(*current)) continue;
                 if (current->trade(*group)) break;
             }
             this->groups.push_back(group);
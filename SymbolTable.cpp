@@ -0,0 +1,38 @@
+#include "SymbolTable.h"
+
+namespace mtm {
+
+    /**
+     * Class fields:
+     *  SymbolMap symbols;
+     *  std::vector<const std::string*> names;
+     */
+
+    SymbolTable::SymbolTable() {
+        this->intern("");
+    }
+
+    SymbolTable::Symbol SymbolTable::intern(const std::string& name) {
+        SymbolMap::const_iterator found = this->symbols.find(name);
+        if (found != this->symbols.end()) return found->second;
+        Symbol symbol = Symbol(this->size());
+        SymbolMap::iterator inserted =
+                this->symbols.insert(std::make_pair(name, symbol)).first;
+        this->names.push_back(&inserted->first);
+        return symbol;
+    }
+
+    SymbolTable::Symbol SymbolTable::find(const std::string& name) const {
+        SymbolMap::const_iterator found = this->symbols.find(name);
+        if (found == this->symbols.end()) return NOT_FOUND;
+        return found->second;
+    }
+
+    const std::string& SymbolTable::name(Symbol symbol) const {
+        return *this->names[symbol];
+    }
+
+    std::size_t SymbolTable::size() const {
+        return this->names.size();
+    }
+}
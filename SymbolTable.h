@@ -0,0 +1,83 @@
+#ifndef MTM4_SYMBOL_TABLE_H
+#define MTM4_SYMBOL_TABLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "MtmString.h"
+
+namespace mtm{
+
+    /**
+     * Interns names: every distinct string gets a small integer, its symbol,
+     * and the same string always gets the same symbol. Two names from the
+     * same table are equal if and only if their symbols are equal, so they
+     * are compared as integers, and the string is only needed to print it.
+     * Symbols of different tables can't be compared.
+     */
+    class SymbolTable{
+    public:
+        typedef std::uint32_t Symbol;
+
+        enum : Symbol{
+            EMPTY = 0, /* The symbol of the empty string, in every table */
+            NOT_FOUND = 0xFFFFFFFF
+        };
+
+    private:
+        typedef std::unordered_map<std::string, Symbol, MtmStringHash,
+                MtmStringEqual> SymbolMap;
+
+        SymbolMap symbols;
+
+        /* The name of every symbol, pointing to the keys of symbols (which
+         * never move) */
+        std::vector<const std::string*> names;
+
+    public:
+        /**
+         * Empty constructor
+         * Creates a table with only the empty string.
+         */
+        SymbolTable();
+
+        /**
+         * Disable copy constructor and assignment operator, the groups that
+         * use a table keep a pointer to it.
+         */
+        SymbolTable(const SymbolTable&) = delete;
+        SymbolTable& operator=(const SymbolTable&) = delete;
+
+        /**
+         * Get the symbol of a name, adding the name to the table if it is
+         * not in it yet.
+         * @param name The name.
+         * @return The symbol of the name.
+         */
+        Symbol intern(const std::string& name);
+
+        /**
+         * Get the symbol of a name, without adding it.
+         * @param name The name.
+         * @return The symbol of the name, or NOT_FOUND if it was never
+         *  interned (so no name in the table is equal to it).
+         */
+        Symbol find(const std::string& name) const;
+
+        /**
+         * @param symbol A symbol of this table.
+         * @return The name that the symbol stands for.
+         */
+        const std::string& name(Symbol symbol) const;
+
+        /**
+         * @return The amount of names in the table, including the empty
+         *  string.
+         */
+        std::size_t size() const;
+    };
+} // namespace mtm
+
+#endif //MTM4_SYMBOL_TABLE_H
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <string>
 #include <stdexcept>
 #include <cassert>
@@ -19,11 +20,9 @@ namespace mtm {
      * @return True if the key was found in the map, and false, otherwise.
      */
     template<typename key_type, typename value_type>
-    bool mapContainsKey(key_type key, map <key_type, value_type> map) {
-        for (std::pair<key_type, value_type> current : map) {
-            if (current.first == key) return true;
-        }
-        return false;
+    bool mapContainsKey(const key_type& key,
+                        const map <key_type, value_type>& map) {
+        return map.find(key) != map.end();
     }
 
     bool World::hasGroup(cstring group_name) const {
@@ -73,7 +72,10 @@ namespace mtm {
         if (mapContainsKey<string, Clan>(new_clan, this->clan_map)) {
             throw WorldClanNameIsTaken();
         }
-        clan_map.insert(std::pair<string, Clan>(new_clan, Clan(new_clan)));
+        Clan clan(new_clan);
+        clan.intern(this->symbols);
+        clan.joinFriendships(this->friendships);
+        clan_map.insert(std::pair<string, Clan>(new_clan, clan));
     }
 
     /**
@@ -216,6 +218,45 @@ namespace mtm {
         clan_map.at(clan1).makeFriend(clan_map.at(clan2));
     }
 
+    /**
+     * Check if two clans are allies: if they are connected by a chain of
+     * friendships (every clan is an ally of itself).
+     * @param clan1 The name of one of the clans.
+     * @param clan2 The name of the other clan.
+     * @return true if the clans are allies, false otherwise.
+     * @throws WorldClanNotFound If at least one of the clans isn't in
+     * the world.
+     */
+    bool World::areAllies(cstring clan1, cstring clan2) const {
+        if(!mapContainsKey(clan1,clan_map) || !mapContainsKey(clan2,clan_map)){
+            throw WorldClanNotFound();
+        }
+        return this->friendships.areAllies(this->symbols.find(clan1),
+                                           this->symbols.find(clan2));
+    }
+
+    /**
+     * Get the alliances of the world: the groups of clans that are
+     * connected by chains of friendships. A clan with no friends is an
+     * alliance of its own.
+     * @return The names of the clans of every alliance, sorted, and the
+     *  alliances sorted by their first names.
+     */
+    std::vector<std::vector<string>> World::getAlliances() const {
+        std::vector<std::vector<string>> alliances;
+        for (const std::vector<FriendshipGraph::Node>& alliance
+                : this->friendships.getAlliances()) {
+            std::vector<string> names;
+            for (FriendshipGraph::Node clan : alliance) {
+                names.push_back(this->symbols.name(clan));
+            }
+            std::sort(names.begin(), names.end());
+            alliances.push_back(names);
+        }
+        std::sort(alliances.begin(), alliances.end());
+        return alliances;
+    }
+
     /**
      * Unite to clans to a new clan with a new name.
      * @param clan1 The name of one of the clan that need to unite.
@@ -241,7 +282,10 @@ namespace mtm {
         Clan& given_clan2 = clan_map.at(clan2);
     
         if (new_name != clan1 && new_name != clan2) {
-            clan_map.insert(std::pair<string, Clan>(new_name, Clan(new_name)));
+            Clan clan(new_name);
+            clan.intern(this->symbols);
+            clan.joinFriendships(this->friendships);
+            clan_map.insert(std::pair<string, Clan>(new_name, clan));
         }
         Clan& united_clan = clan_map.at(new_name);
         if (new_name != clan1) united_clan.unite(given_clan1, new_name);
@@ -3,7 +3,10 @@
 
 #include "Clan.h"
 #include "Area.h"
+#include "SymbolTable.h"
+#include "FriendshipGraph.h"
 #include <map>
+#include <vector>
 
 namespace mtm{
     typedef std::shared_ptr<Area> AreaPtr;
@@ -12,6 +15,19 @@ namespace mtm{
     enum AreaType{ PLAIN, MOUNTAIN, RIVER };
     
     class World{
+        /**
+         * The names of all the clans and groups in the world. Declared
+         * first, so it is destroyed after the clans and groups that point
+         * to it.
+         */
+        SymbolTable symbols;
+
+        /**
+         * The friendships between the clans of the world, by the symbols of
+         * their names. Declared before the clans, that point to it.
+         */
+        FriendshipGraph friendships;
+
         map<string, Clan> clan_map;
         map<string, AreaPtr> area_map;
 
@@ -128,6 +144,26 @@ namespace mtm{
          * the world.
          */
         void makeFriends(cstring clan1, cstring clan2);
+
+        /**
+         * Check if two clans are allies: if they are connected by a chain of
+         * friendships (every clan is an ally of itself).
+         * @param clan1 The name of one of the clans.
+         * @param clan2 The name of the other clan.
+         * @return true if the clans are allies, false otherwise.
+         * @throws WorldClanNotFound If at least one of the clans isn't in
+         * the world.
+         */
+        bool areAllies(cstring clan1, cstring clan2) const;
+
+        /**
+         * Get the alliances of the world: the groups of clans that are
+         * connected by chains of friendships. A clan with no friends is an
+         * alliance of its own.
+         * @return The names of the clans of every alliance, sorted, and the
+         *  alliances sorted by their first names.
+         */
+        std::vector<std::vector<string>> getAlliances() const;
         
         
         /**
@@ -0,0 +1,77 @@
+/**
+ * Scaling benchmark for MtmConcurrentSet.
+ * Every thread runs the same read-mostly mix (90% contains, 5% insert,
+ * 5% erase) on one shared set, for 1 up to the number of cores threads.
+ *
+ * Build (from the repository root):
+ *  g++ -std=c++11 -O2 -pthread bench/MtmConcurrentSet_bench.cpp
+ *      -o concurrent_bench
+ */
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include "../MtmConcurrentSet.h"
+
+using namespace mtm;
+
+/**
+ * A small xorshift generator, so threads don't share the state of a
+ * standard engine.
+ */
+class Random {
+    unsigned state;
+public:
+    explicit Random(unsigned seed) : state(seed * 2654435761u + 1) {
+    }
+    unsigned next() {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return state;
+    }
+};
+
+int main() {
+    const int keys = 1 << 16;
+    const int operations = 1000000;
+    unsigned cores = std::thread::hardware_concurrency();
+    if (cores == 0) cores = 4;
+    std::vector<unsigned> thread_counts;
+    for (unsigned threads = 1; threads < cores; threads *= 2) {
+        thread_counts.push_back(threads);
+    }
+    thread_counts.push_back(cores);
+    std::cout << "Operations per thread: " << operations << std::endl;
+    for (unsigned threads : thread_counts) {
+        MtmConcurrentSet<int> set;
+        for (int i = 0; i < keys; i += 2) set.insert(i);
+        std::vector<std::thread> workers;
+        std::chrono::steady_clock::time_point start =
+                std::chrono::steady_clock::now();
+        for (unsigned t = 0; t < threads; ++t) {
+            workers.push_back(std::thread([&set, t]() {
+                Random random(t + 1);
+                for (int i = 0; i < operations; ++i) {
+                    unsigned value = random.next();
+                    int key = int(value % keys);
+                    unsigned kind = (value >> 20) % 20;
+                    if (kind == 0) {
+                        set.insert(key);
+                    } else if (kind == 1) {
+                        set.erase(key);
+                    } else {
+                        set.contains(key);
+                    }
+                }
+            }));
+        }
+        for (std::thread& worker : workers) worker.join();
+        std::chrono::duration<double> elapsed =
+                std::chrono::steady_clock::now() - start;
+        std::cout << threads << " threads: "
+                  << threads * operations / elapsed.count() / 1e6
+                  << " million operations per second" << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,103 @@
+/**
+ * Scaling benchmark for the parallel MtmSet operations.
+ * Runs unite, intersect, isSuperSetOf and getSubSet on two large name sets,
+ * serially and in parallel with 1 up to the number of cores threads.
+ * First measures the costs that parallel::MIN_WORK_PER_THREAD is based on:
+ * starting and joining a thread, and comparing two names.
+ *
+ * Build (from the repository root):
+ *  g++ -std=c++11 -O2 -pthread bench/MtmParallel_bench.cpp -o parallel_bench
+ */
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../MtmParallel.h"
+#include "../MtmSet.h"
+
+using namespace mtm;
+
+/**
+ * Runs a workload once, and prints its time.
+ */
+template<typename Workload>
+void measure(const std::string& title, Workload workload) {
+    std::chrono::steady_clock::time_point start =
+            std::chrono::steady_clock::now();
+    int result = workload();
+    std::chrono::duration<double, std::milli> elapsed =
+            std::chrono::steady_clock::now() - start;
+    std::cout << title << ": " << elapsed.count() << " ms (result "
+              << result << ")" << std::endl;
+}
+
+bool hasEvenLength(const std::string& name) {
+    return name.size() % 2 == 0;
+}
+
+int main() {
+    const int starts = 1000;
+    measure(std::to_string(starts) + " thread starts and joins", [&]() {
+        for (int i = 0; i < starts; ++i) {
+            std::thread thread([]() {});
+            thread.join();
+        }
+        return starts;
+    });
+    MtmSet<std::string> small;
+    for (int i = 0; i < 2000; ++i) small.insert("group" + std::to_string(i));
+    measure("4000000 name comparisons", [&]() {
+        int found = 0;
+        for (const std::string& name : small) {
+            found += int(small.contains(name + "!"));
+        }
+        return found;
+    });
+
+    const int elements = 20000;
+    MtmSet<std::string> names1;
+    MtmSet<std::string> names2;
+    for (int i = 0; i < elements; ++i) {
+        names1.insert("group" + std::to_string(i));
+        names2.insert("group" + std::to_string(i + elements / 2));
+    }
+    const MtmSet<std::string>& const_names1 = names1;
+    std::cout << "Sets of " << elements << " names" << std::endl;
+    measure("serial unite", [&]() {
+        return const_names1.unite(names2).size();
+    });
+    measure("serial intersect", [&]() {
+        return const_names1.intersect(names2).size();
+    });
+    measure("serial isSuperSetOf", [&]() {
+        return int(names1.isSuperSetOf(names1));
+    });
+    measure("serial getSubSet", [&]() {
+        return const_names1.getSubSet(hasEvenLength).size();
+    });
+
+    unsigned cores = std::thread::hardware_concurrency();
+    if (cores == 0) cores = 4;
+    std::vector<unsigned> thread_counts;
+    for (unsigned threads = 1; threads < cores; threads *= 2) {
+        thread_counts.push_back(threads);
+    }
+    thread_counts.push_back(cores);
+    for (unsigned threads : thread_counts) {
+        std::string prefix = std::to_string(threads) + " threads ";
+        measure(prefix + "unite", [&]() {
+            return parallelUnite(names1, names2, threads).size();
+        });
+        measure(prefix + "intersect", [&]() {
+            return parallelIntersect(names1, names2, threads).size();
+        });
+        measure(prefix + "isSuperSetOf", [&]() {
+            return int(parallelIsSuperSetOf(names1, names1, threads));
+        });
+        measure(prefix + "getSubSet", [&]() {
+            return parallelGetSubSet(names1, hasEvenLength, threads).size();
+        });
+    }
+    return 0;
+}
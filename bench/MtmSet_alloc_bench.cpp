@@ -0,0 +1,123 @@
+/**
+ * Allocation-count benchmark for MtmSet.
+ * Counts the calls to the global operator new made while building name
+ * sets, the way Area::getGroupsNames() does on every call.
+ * The baseline is std::list, which allocates one node per element like
+ * MtmSet did before its nodes were pooled.
+ *
+ * Build (from the repository root):
+ *  g++ -std=c++11 -O2 bench/MtmSet_alloc_bench.cpp Area.cpp Clan.cpp
+ *      Group.cpp SymbolTable.cpp FriendshipGraph.cpp -o alloc_bench
+ */
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <list>
+#include <map>
+#include <new>
+#include <string>
+#include <vector>
+#include "../Area.h"
+#include "../Clan.h"
+#include "../MtmPersistentSet.h"
+#include "../MtmSet.h"
+
+using namespace mtm;
+
+static long allocation_count = 0;
+
+void* operator new(std::size_t size) {
+    ++allocation_count;
+    void* memory = std::malloc(size ? size : 1);
+    if (!memory) throw std::bad_alloc();
+    return memory;
+}
+
+/* The replaced operator new above allocates with malloc, but GCC 11 and
+ * later still see free() on the result of a new expression once these are
+ * inlined, and warn about a mismatch */
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+void operator delete(void* memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept {
+    std::free(memory);
+}
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic pop
+#endif
+
+/**
+ * Runs a workload a given amount of times, and prints the allocations and
+ * time per run.
+ */
+template<typename Workload>
+void measure(const std::string& title, int runs, Workload workload) {
+    long allocations_before = allocation_count;
+    std::chrono::steady_clock::time_point start =
+            std::chrono::steady_clock::now();
+    for (int i = 0; i < runs; ++i) workload();
+    std::chrono::duration<double, std::micro> elapsed =
+            std::chrono::steady_clock::now() - start;
+    std::cout << title << ": "
+              << double(allocation_count - allocations_before) / runs
+              << " allocations, " << elapsed.count() / runs << " us per run"
+              << std::endl;
+}
+
+int main() {
+    const int groups = 500;
+    const int runs = 200;
+    /* Short names, so std::string doesn't allocate and only the set's own
+     * allocations are counted. */
+    std::map<string, Clan> clan_map;
+    clan_map.insert(std::pair<string, Clan>("clan", Clan("clan")));
+    Area area("area");
+    for (int i = 0; i < groups; ++i) {
+        string name = "g" + std::to_string(i);
+        clan_map.at("clan").addGroup(Group(name, 1, 1));
+        area.groupArrive(name, "clan", clan_map);
+    }
+    std::cout << "Name sets of " << groups << " groups" << std::endl;
+    measure("Area::getGroupsNames (pooled MtmSet)", runs, [&area]() {
+        MtmSet<string> names = area.getGroupsNames();
+        (void)names;
+    });
+    MtmSet<string> names = area.getGroupsNames();
+    measure("std::list copy (node per element)", runs, [&names]() {
+        std::list<string> copied;
+        for (const string& name : names) copied.push_back(name);
+    });
+    measure("MtmSet copy (pooled)", runs, [&names]() {
+        MtmSet<string> copied(names);
+        (void)copied;
+    });
+    MtmPersistentSet<string> persistent(names.begin(), names.end());
+    measure("MtmPersistentSet copy (shared)", runs, [&persistent]() {
+        MtmPersistentSet<string> copied(persistent);
+        (void)copied;
+    });
+    measure("MtmPersistentSet copy + insert", runs, [&persistent]() {
+        MtmPersistentSet<string> copied(persistent);
+        copied.insert("new");
+    });
+
+    /* Friend sets, like Clan::friends, that hold fewer than 8 clans. */
+    const int friends = 6;
+    std::vector<Clan> clans;
+    for (int i = 0; i < friends; ++i) clans.push_back(Clan("friend"));
+    std::cout << "Sets of " << friends << " clan pointers" << std::endl;
+    measure("MtmSet<Clan*>", runs, [&clans]() {
+        MtmSet<Clan*> set;
+        for (Clan& clan : clans) set.insert(&clan);
+    });
+    measure("MtmSet<Clan*, 8> (inline)", runs, [&clans]() {
+        MtmSet<Clan*, 8> set;
+        for (Clan& clan : clans) set.insert(&clan);
+    });
+    return 0;
+}
@@ -0,0 +1,92 @@
+/**
+ * Iteration benchmark for the MtmSet iteration policies.
+ * Runs the two iteration-heavy loops of the game, a friend lookup like
+ * Clan::isFriend and a membership scan of names like World::getGroupArea,
+ * plus a plain sum, with checked and with unchecked iterators.
+ *
+ * Build (from the repository root):
+ *  g++ -std=c++11 -O2 bench/MtmSet_iteration_bench.cpp -o iteration_bench
+ */
+#include <chrono>
+#include <iostream>
+#include <string>
+#include "../MtmSet.h"
+
+using namespace mtm;
+
+/**
+ * Runs a workload a given amount of times, and prints the time per run.
+ * The workload returns a value, which is printed so the loop isn't
+ * optimized away.
+ */
+template<typename Workload>
+void measure(const std::string& title, int runs, Workload workload) {
+    long result = 0;
+    std::chrono::steady_clock::time_point start =
+            std::chrono::steady_clock::now();
+    for (int i = 0; i < runs; ++i) result += workload();
+    std::chrono::duration<double, std::micro> elapsed =
+            std::chrono::steady_clock::now() - start;
+    std::cout << title << ": " << elapsed.count() / runs << " us per run"
+              << " (result " << result << ")" << std::endl;
+}
+
+/**
+ * Find a pointer by walking the set with its iterators.
+ */
+template<typename Set>
+long findByIteration(const Set& set, const int* wanted) {
+    for (const int* current : set) {
+        if (current == wanted) return 1;
+    }
+    return 0;
+}
+
+template<typename Set>
+long sum(const Set& set) {
+    long total = 0;
+    for (typename Set::const_iterator it = set.begin(); it != set.end();
+         ++it) {
+        total += *it;
+    }
+    return total;
+}
+
+template<typename Set>
+long countPrefixed(const Set& set, char prefix) {
+    long count = 0;
+    for (const std::string& name : set) {
+        if (name[0] == prefix) ++count;
+    }
+    return count;
+}
+
+template<typename Checking>
+void run(const std::string& policy) {
+    const int elements = 4096;
+    const int runs = 2000;
+    static int values[elements];
+    MtmSet<const int*, 0, Checking> pointers;
+    MtmSet<int, 0, Checking> numbers;
+    MtmSet<std::string, 0, Checking> names;
+    for (int i = 0; i < elements; ++i) {
+        pointers.insert(&values[i]);
+        numbers.insert(i);
+        names.insert((i % 2 ? "g" : "h") + std::to_string(i));
+    }
+    measure(policy + " friend lookup", runs, [&pointers]() {
+        return findByIteration(pointers, &values[elements - 1]);
+    });
+    measure(policy + " sum", runs, [&numbers]() {
+        return sum(numbers);
+    });
+    measure(policy + " name scan", runs, [&names]() {
+        return countPrefixed(names, 'g');
+    });
+}
+
+int main() {
+    run<MtmCheckedIteration>("checked");
+    run<MtmUncheckedIteration>("unchecked");
+    return 0;
+}
@@ -0,0 +1,97 @@
+/**
+ * Memory benchmark for PackedGroup.
+ * Keeps the same groups as Group objects and as PackedGroup objects (with
+ * the SymbolTable of their names), and prints the bytes per group that each
+ * representation takes on the heap, counted by a replaced operator new.
+ *
+ * Build (from the repository root):
+ *  g++ -std=c++11 -O2 bench/PackedGroup_memory_bench.cpp Group.cpp
+ *      PackedGroup.cpp SymbolTable.cpp -o memory_bench
+ */
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+#include "../Group.h"
+#include "../PackedGroup.h"
+
+using namespace mtm;
+
+static std::size_t allocated = 0;
+
+void* operator new(std::size_t size) {
+    allocated += size;
+    void* memory = std::malloc(size);
+    if (!memory) throw std::bad_alloc();
+    return memory;
+}
+
+/* The replaced operator new above allocates with malloc, but GCC 11 and
+ * later still see free() on the result of a new expression once these are
+ * inlined, and warn about a mismatch */
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+void operator delete(void* memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept {
+    std::free(memory);
+}
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic pop
+#endif
+
+/**
+ * Prints the bytes per group that a representation takes.
+ */
+static void report(const std::string& title, std::size_t bytes, int groups) {
+    std::cout << title << ": " << double(bytes) / groups
+              << " bytes per group" << std::endl;
+}
+
+int main() {
+    const int group_count = 100000;
+    const int clan_count = 50;
+    /* Names long enough not to fit in the small string buffer */
+    std::vector<std::string> names, clans;
+    for (int i = 0; i < group_count; ++i) {
+        names.push_back("Group of the house number " + std::to_string(i));
+    }
+    for (int i = 0; i < clan_count; ++i) {
+        clans.push_back("Clan of the realm number " + std::to_string(i));
+    }
+
+    std::size_t before = allocated;
+    std::vector<Group> groups;
+    groups.reserve(group_count);
+    for (int i = 0; i < group_count; ++i) {
+        groups.push_back(Group(names[i], clans[i % clan_count],
+                               (i * 7) % 130, (i * 5) % 110 + 1,
+                               (i * 11) % 170, (i * 13) % 190,
+                               (i * 29) % 101));
+    }
+    std::size_t group_bytes = allocated - before;
+
+    before = allocated;
+    SymbolTable table;
+    std::size_t table_before = allocated;
+    std::vector<PackedGroup> packed;
+    packed.reserve(group_count);
+    std::size_t vector_bytes = allocated - table_before;
+    for (const Group& group : groups) {
+        packed.push_back(PackedGroup(group, table));
+    }
+    std::size_t packed_bytes = allocated - before;
+
+    std::cout << "sizeof(Group) = " << sizeof(Group)
+              << ", sizeof(PackedGroup) = " << sizeof(PackedGroup)
+              << std::endl;
+    report("Group", group_bytes, group_count);
+    report("PackedGroup (groups only)", vector_bytes, group_count);
+    report("PackedGroup (with the names)", packed_bytes, group_count);
+    return packed_bytes < group_bytes ? 0 : 1;
+}
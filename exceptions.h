@@ -18,6 +18,7 @@ namespace mtm{
     NEW_EXCEPTION(GroupCantFightEmptyGroup, GroupException);
     NEW_EXCEPTION(GroupCantTradeWithItself, GroupException);
     NEW_EXCEPTION(GroupCantDivide, GroupException);
+    NEW_EXCEPTION(GroupOverflow, GroupException);
     
     NEW_EXCEPTION(ClanException, std::exception);
     NEW_EXCEPTION(ClanEmptyName, ClanException);
@@ -48,5 +49,6 @@ namespace mtm{
     NEW_EXCEPTION(MTMSetException, std::exception);
     NEW_EXCEPTION(MTMSetNodeException, MTMSetException);
     NEW_EXCEPTION(NodeIsEndException, MTMSetNodeException);
+    NEW_EXCEPTION(MTMSetElementOutOfDomain, MTMSetException);
 }
 #endif //MTM4_EXCEPTIONS_H
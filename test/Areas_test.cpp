@@ -5,6 +5,7 @@
 #include "../River.h"
 #include "../Plain.h"
 #include "../Mountain.h"
+#include "../SymbolTable.h"
 #include "../exceptions.h"
 
 using namespace mtm;
@@ -314,10 +315,48 @@ bool testRiver(){
     return true;
 }
 
+bool testMountainInterned(){
+    SymbolTable table;
+    AreaPtr carmel(new Mountain("Carmel"));
+    std::map<std::string, Clan> clan_map = makeClanMap();
+    for (std::map<std::string, Clan>::value_type& entry : clan_map) {
+        entry.second.intern(table);
+    }
+    ASSERT_NO_EXCEPTION(carmel->groupArrive("Estonian", "Apache", clan_map));
+    ASSERT_NO_EXCEPTION(carmel->groupArrive("Aragonian", "Apache", clan_map));
+    // the ruler is found by the symbol of its name, and fights
+
+    ostringstream os;
+    ASSERT_NO_EXCEPTION(carmel->groupArrive("Aragonian2", "Apache2", clan_map));
+    ASSERT_NO_EXCEPTION(os << *clan_map.at("Apache2").getGroup("Aragonian2"));
+    ASSERT_TRUE(VerifyOutput(os, "Group's name: Aragonian2\n"
+            "Group's clan: Apache2\n"
+            "Group's children: 6\n"
+            "Group's adults: 6\n"
+            "Group's tools: 0\n"
+            "Group's food: 1\n"
+            "Group's morale: 56\n"));
+
+    ASSERT_NO_EXCEPTION(carmel->groupLeave("Aragonian"));
+    // Estonian becomes dominant, and loses to the Werewolves
+
+    ASSERT_NO_EXCEPTION(carmel->groupArrive("Werewolves", "Coyote", clan_map));
+    ASSERT_NO_EXCEPTION(os << *clan_map.at("Apache").getGroup("Estonian"));
+    ASSERT_TRUE(VerifyOutput(os, "Group's name: Estonian\n"
+            "Group's clan: Apache\n"
+            "Group's children: 20\n"
+            "Group's adults: 15\n"
+            "Group's tools: 20\n"
+            "Group's food: 0\n"
+            "Group's morale: 65\n"));
+    return true;
+}
+
 int main(){
     /* All exceptions are tested in testPlain, so the other two test don't test them. */
     RUN_TEST(testPlain);
     RUN_TEST(testMountain);
+    RUN_TEST(testMountainInterned);
     RUN_TEST(testRiver);
     return 0;
 }
\ No newline at end of file
@@ -1,3 +1,7 @@
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
 #include "../Clan.h"
 #include "../exceptions.h"
 #include "testMacros.h"
@@ -137,7 +141,422 @@ bool testClan(){
       return true;
 }
 
+bool testClanMoveGroups() {
+    Clan north("The North");
+    Group stark("Stark with a name too long to be stored inline", 20, 30);
+    const char* name_characters = stark.getName().data();
+    north.addGroup(std::move(stark));
+    const GroupPointer& moved =
+            north.getGroup("Stark with a name too long to be stored inline");
+    ASSERT_TRUE(moved->getName().data() == name_characters);
+    ASSERT_TRUE(moved->getClan() == "The North");
+
+    ASSERT_NO_EXCEPTION(north.emplaceGroup("Bolton", "", 40, 63, 200, 350,
+                                           70));
+    ASSERT_NO_EXCEPTION(north.emplaceGroup("Mormont", 40, 60));
+    ASSERT_TRUE(north.getGroup("Bolton")->getClan() == "The North");
+    ASSERT_TRUE(north.getGroup("Mormont")->getSize() == 100);
+    ASSERT_TRUE(north.getSize() == 50 + 103 + 100);
+    ASSERT_EXCEPTION(north.emplaceGroup("Bolton", 1, 1),
+                     ClanGroupNameAlreadyTaken);
+    ASSERT_EXCEPTION(north.emplaceGroup("Karstark", 0, 0), GroupInvalidArgs);
+    ASSERT_EXCEPTION(north.addGroup(Group("Bolton", 1, 1)),
+                     ClanGroupNameAlreadyTaken);
+
+    /* Divided groups are moved into the clan */
+    Group umber("Umber", 20, 20);
+    north.addGroup(umber.divide("Umber_2"));
+    ASSERT_TRUE(north.doesContain("Umber_2"));
+    ASSERT_TRUE(north.getGroup("Umber_2")->getSize() == 20);
+    return true;
+}
+
+bool testClanIndex() {
+    Clan north("The North");
+    north.addGroup(Group("Stark", "", 20, 30, 40, 50, 80));
+    north.addGroup(Group("Bolton", "", 10, 30, 40, 50, 80));
+    north.addGroup(Group("Umber", "", 10, 20, 10, 10, 80));
+    north.addGroup(Group("Karstark", "", 1, 1, 0, 0, 80));
+
+    /* The weaker group takes the name of the stronger one, and the other
+     * one loses its name */
+    ASSERT_TRUE(north.getGroup("Bolton")->unite(*north.getGroup("Stark"),
+                                                1000));
+    ASSERT_TRUE(north.doesContain("Stark"));
+    ASSERT_FALSE(north.doesContain("Bolton"));
+    ASSERT_TRUE(north.getGroup("Stark")->getSize() == 90);
+    ASSERT_TRUE(north.getSize() == 90 + 30 + 2);
+
+    /* A group that lost all of its people loses its name, and the clan
+     * contains a group with no name, that can't be got */
+    GroupPointer karstark = north.getGroup("Karstark");
+    ASSERT_TRUE(north.getGroup("Umber")->fight(*karstark) == WON);
+    ASSERT_FALSE(north.doesContain("Karstark"));
+    ASSERT_TRUE(north.doesContain(""));
+    ASSERT_EXCEPTION(north.getGroup(""), ClanGroupNotFound);
+    *karstark = Group("Karstark", 1, 1);
+    ASSERT_TRUE(north.doesContain("Karstark") && north.doesContain(""));
+
+    /* A group that is assigned to is found by its new name */
+    *north.getGroup("Umber") = Group("Mormont", 5, 5);
+    ASSERT_TRUE(north.doesContain("Mormont"));
+    ASSERT_FALSE(north.doesContain("Umber"));
+    north.addGroup(Group("Umber", 1, 1));
+    ASSERT_TRUE(north.getGroup("Umber")->getSize() == 2);
+
+    /* A copy of the clan shares its groups, and both clans are told about
+     * their changes */
+    Clan copy(north);
+    ASSERT_TRUE(copy.getGroup("Mormont")->fight(*copy.getGroup("Umber"))
+                == WON);
+    ASSERT_FALSE(copy.doesContain("Umber"));
+    ASSERT_FALSE(north.doesContain("Umber"));
+    ASSERT_TRUE(north.getSize() == copy.getSize());
+    *north.getGroup("Mormont") = Group("Glover", 5, 5);
+    ASSERT_TRUE(copy.doesContain("Glover") && north.doesContain("Glover"));
+    ASSERT_FALSE(copy.doesContain("Mormont"));
+
+    /* A copy that is destroyed stops listening, without changing the
+     * original */
+    {
+        Clan temporary(north);
+        ASSERT_TRUE(temporary.doesContain("Glover"));
+    }
+    *north.getGroup("Glover") = Group("Mormont", 5, 5);
+    ASSERT_TRUE(north.doesContain("Mormont") && copy.doesContain("Mormont"));
+
+    /* A copy is still told about changes once the clan that it was copied
+     * from is destroyed */
+    std::unique_ptr<Clan> wall(new Clan("The Wall"));
+    wall->addGroup(Group("Watch", 10, 10));
+    Clan survivor(*wall);
+    GroupPointer watch = survivor.getGroup("Watch");
+    wall.reset();
+    *watch = Group("Wildlings", 1, 1);
+    ASSERT_TRUE(survivor.doesContain("Wildlings"));
+    ASSERT_TRUE(survivor.getSize() == 2);
+
+    /* The groups of the other clan are found in the united clan */
+    Clan vale("The Vale");
+    vale.addGroup(Group("Arryn", 10, 10));
+    vale.addGroup(Group("Royce", 10, 10));
+    copy.unite(vale, "The North and the Vale");
+    ASSERT_TRUE(copy.doesContain("Arryn") && copy.doesContain("Stark"));
+    ASSERT_FALSE(vale.doesContain("Arryn"));
+    ASSERT_FALSE(north.doesContain("Arryn"));
+    ASSERT_TRUE(north.doesContain("Stark"));
+    Clan riverlands("Riverlands");
+    riverlands.addGroup(Group("Royce", 1, 1));
+    ASSERT_EXCEPTION(riverlands.unite(copy, "Rivers"), ClanCantUnite);
+    ASSERT_EXCEPTION(copy.unite(riverlands, "Rivers"), ClanCantUnite);
+
+    /* Clans that both have groups with no name can't unite */
+    Clan crownlands("The Crownlands");
+    crownlands.addGroup(Group("Rosby", 10, 10));
+    crownlands.addGroup(Group("Stokeworth", 1, 1));
+    ASSERT_TRUE(crownlands.getGroup("Rosby")
+                        ->fight(*crownlands.getGroup("Stokeworth")) == WON);
+    ASSERT_EXCEPTION(crownlands.unite(copy, "Crowns"), ClanCantUnite);
+    ASSERT_EXCEPTION(copy.unite(crownlands, "Crowns"), ClanCantUnite);
+
+    /* The friends of a united clan keep listening to their groups */
+    Clan dorne("Dorne");
+    dorne.addGroup(Group("Martell", "", 20, 30, 40, 50, 80));
+    dorne.addGroup(Group("Dayne", "", 10, 30, 40, 50, 80));
+    riverlands.makeFriend(dorne);
+    vale.addGroup(Group("Corbray", 1, 1));
+    vale.unite(riverlands, "The Vale");
+    ASSERT_TRUE(dorne.getGroup("Dayne")->unite(*dorne.getGroup("Martell"),
+                                               1000));
+    ASSERT_FALSE(dorne.doesContain("Dayne"));
+    ASSERT_TRUE(dorne.getGroup("Martell")->getSize() == 90);
+
+    /* A group with no name is found when it gets one, also after a unite
+     * dropped the ranking */
+    Clan reach("The Reach");
+    reach.addGroup(Group("Tyrell", 10, 10));
+    reach.addGroup(Group("Tarly", 1, 1));
+    GroupPointer tarly = reach.getGroup("Tarly");
+    ASSERT_TRUE(reach.getGroup("Tyrell")->fight(*tarly) == WON);
+    Clan stormlands("Stormlands");
+    stormlands.addGroup(Group("Baratheon", 5, 5));
+    reach.unite(stormlands, "The South");
+    *tarly = Group("Florent", 1, 1);
+    ASSERT_TRUE(reach.getGroup("Florent") == tarly);
+    std::vector<GroupPointer> strongest = reach.getStrongestGroups(3);
+    ASSERT_TRUE(strongest.size() == 3 && strongest[2] == tarly);
+    return true;
+}
+
+/**
+ * Checks that the totals of a clan are the sums of the totals of groups.
+ */
+static bool hasTotals(const Clan& clan,
+                      const std::vector<GroupPointer>& groups) {
+    GroupTotals sum = GroupTotals();
+    for (const GroupPointer& group : groups) {
+        GroupTotals totals = group->getTotals();
+        sum.people += totals.people;
+        sum.tools += totals.tools;
+        sum.food += totals.food;
+        sum.power += totals.power;
+    }
+    GroupTotals totals = clan.getTotals();
+    return totals.people == sum.people && totals.tools == sum.tools
+           && totals.food == sum.food && totals.power == sum.power
+           && clan.getSize() == sum.people;
+}
+
+bool testClanTotals() {
+    Clan north("The North");
+    ASSERT_TRUE(hasTotals(north, {}));
+    north.addGroup(Group("Stark", "", 20, 30, 40, 10, 80));
+    north.addGroup(Group("Bolton", "", 10, 30, 5, 60, 75));
+    north.addGroup(Group("Umber", "", 10, 20, 10, 10, 80));
+    std::vector<GroupPointer> groups = {north.getGroup("Stark"),
+                                        north.getGroup("Bolton"),
+                                        north.getGroup("Umber")};
+    ASSERT_TRUE(hasTotals(north, groups));
+
+    ASSERT_TRUE(groups[0]->trade(*groups[1]));
+    ASSERT_TRUE(hasTotals(north, groups));
+    ASSERT_TRUE(groups[0]->fight(*groups[2]) == WON);
+    ASSERT_TRUE(hasTotals(north, groups));
+    north.addGroup(groups[1]->divide("Bolton_2"));
+    groups.push_back(north.getGroup("Bolton_2"));
+    ASSERT_TRUE(hasTotals(north, groups));
+    ASSERT_TRUE(groups[1]->unite(*groups[3], 1000));
+    ASSERT_TRUE(hasTotals(north, groups));
+
+    /* A group outside of the clan doesn't change its totals */
+    Group outside("Outside", 10, 10);
+    ASSERT_TRUE(outside.fight(*groups[2]) != DRAW);
+    ASSERT_TRUE(hasTotals(north, groups));
+    *groups[2] = Group("Mormont", 5, 5);
+    ASSERT_TRUE(hasTotals(north, groups));
+
+    /* The groups of both clans change their clan, and their morale */
+    Clan vale("The Vale");
+    vale.addGroup(Group("Arryn", 10, 10));
+    groups.push_back(vale.getGroup("Arryn"));
+    north.unite(vale, "The North and the Vale");
+    ASSERT_TRUE(hasTotals(north, groups));
+    ASSERT_TRUE(hasTotals(vale, {}));
+
+    /* A copy shares the groups, and both clans keep their own totals */
+    Clan copy(north);
+    ASSERT_TRUE(hasTotals(copy, groups));
+    *groups[2] = Group("Karstark", "", 10, 20, 50, 5, 80);
+    ASSERT_TRUE(hasTotals(north, groups) && hasTotals(copy, groups));
+    *groups[4] = Group("Hornwood", "", 10, 20, 5, 50, 80);
+    ASSERT_TRUE(groups[4]->trade(*groups[2]));
+    ASSERT_TRUE(hasTotals(north, groups) && hasTotals(copy, groups));
+    ASSERT_TRUE(groups[4]->fight(*groups[2]) != DRAW);
+    ASSERT_TRUE(hasTotals(north, groups) && hasTotals(copy, groups));
+    ASSERT_TRUE(groups[1]->unite(*groups[0], 1000));
+    ASSERT_TRUE(hasTotals(north, groups) && hasTotals(copy, groups));
+    Clan reach("The Reach");
+    reach.addGroup(Group("Tyrell", 10, 10));
+    std::vector<GroupPointer> copy_groups = groups;
+    copy_groups.push_back(reach.getGroup("Tyrell"));
+    copy.unite(reach, "The Realm");
+    ASSERT_TRUE(hasTotals(copy, copy_groups));
+    ASSERT_TRUE(hasTotals(north, groups));
+    ASSERT_TRUE(groups[4]->fight(*copy_groups[5]) != DRAW);
+    ASSERT_TRUE(hasTotals(copy, copy_groups));
+    ASSERT_TRUE(hasTotals(north, groups));
+    return true;
+}
+
+/**
+ * Prints a clan the way operator<< did, by sorting its groups.
+ */
+static std::string sortedClan(const std::string& name,
+                              std::vector<GroupPointer> groups) {
+    std::sort(groups.begin(), groups.end(),
+              [](const GroupPointer& group1, const GroupPointer& group2) {
+        return *group1 > *group2;
+    });
+    ostringstream os;
+    os << "Clan's name: " << name << std::endl << "Clan's groups:"
+       << std::endl;
+    for (const GroupPointer& group : groups) {
+        if (group->getSize() > 0) os << group->getName() << std::endl;
+    }
+    return os.str();
+}
+
+bool testClanRanking() {
+    Clan north("The North");
+    std::vector<GroupPointer> groups;
+    for (int i = 0; i < 40; ++i) {
+        north.addGroup(Group("Group" + std::to_string(i), "", i % 7 + 1,
+                             i % 5 + 1, (i * 11) % 17, (i * 13) % 19, 80));
+        groups.push_back(north.getGroup("Group" + std::to_string(i)));
+    }
+    /* Groups with the same power are ordered by name */
+    north.addGroup(Group("Twin", "", 1, 5, 1, 11, 80));
+    groups.push_back(north.getGroup("Twin"));
+    ostringstream os;
+    os << north;
+    ASSERT_TRUE(os.str() == sortedClan("The North", groups));
+
+    for (int i = 0; i < 40; ++i) {
+        Group& group1 = *groups[i];
+        Group& group2 = *groups[(i * 7 + 3) % 40];
+        if (&group1 == &group2 || group1.getSize() == 0
+            || group2.getSize() == 0) {
+            continue;
+        }
+        if (i % 3 == 0) {
+            group1.fight(group2);
+        } else if (i % 3 == 1) {
+            group1.trade(group2);
+        } else {
+            group1.unite(group2, 10);
+        }
+    }
+    os.str("");
+    os << north;
+    ASSERT_TRUE(os.str() == sortedClan("The North", groups));
+
+    std::vector<GroupPointer> strongest = north.getStrongestGroups(3);
+    ASSERT_TRUE(strongest.size() == 3);
+    ASSERT_TRUE(*strongest[0] > *strongest[1]);
+    ASSERT_TRUE(*strongest[1] > *strongest[2]);
+    for (const GroupPointer& group : groups) {
+        ASSERT_TRUE(group->getSize() == 0 || group == strongest[0]
+                    || *strongest[0] > *group);
+    }
+    ASSERT_TRUE(north.getStrongestGroups(1000).size() <= groups.size());
+    return true;
+}
+
+/**
+ * Prints a group the way it is after changing its clan outside of any clan.
+ */
+static std::string movedGroup(const Group& group, const std::string& clan) {
+    Group moved(group);
+    moved.changeClan(clan);
+    ostringstream os;
+    os << moved;
+    return os.str();
+}
+
+bool testClanUnite() {
+    SymbolTable table;
+    Clan north("The North"), vale("The Vale");
+    north.intern(table);
+    vale.intern(table);
+    std::vector<GroupPointer> groups, joined;
+    for (int i = 0; i < 20; ++i) {
+        north.addGroup(Group("North" + std::to_string(i), "", i % 7 + 1,
+                             i % 5 + 1, (i * 11) % 17, (i * 13) % 19, 80));
+        groups.push_back(north.getGroup("North" + std::to_string(i)));
+        vale.addGroup(Group("Vale" + std::to_string(i), "", i % 5 + 1,
+                            i % 3 + 1, (i * 7) % 13, (i * 5) % 11, 70));
+        joined.push_back(vale.getGroup("Vale" + std::to_string(i)));
+    }
+    /* A group that lost all its people doesn't move to the other clan */
+    ASSERT_TRUE(joined[1]->unite(*joined[0], 1000));
+    std::vector<std::string> expected;
+    for (const GroupPointer& group : joined) {
+        expected.push_back(movedGroup(*group, group->getSize() > 0 ?
+                                              "The North" : group->getClan()));
+    }
+
+    /* As many groups join as are in the clan, so it ranks them later */
+    north.unite(vale, "The North");
+    for (std::size_t i = 0; i < joined.size(); ++i) {
+        ostringstream os;
+        os << *joined[i];
+        ASSERT_TRUE(os.str() == expected[i]);
+        if (i == 0) continue;
+        ASSERT_TRUE(north.getGroup(joined[i]->getName()) == joined[i]);
+        groups.push_back(joined[i]);
+    }
+    ASSERT_TRUE(hasTotals(north, groups));
+    ASSERT_TRUE(hasTotals(vale, {}));
+    ASSERT_FALSE(vale.doesContain("Vale1"));
+    ostringstream os;
+    os << north;
+    ASSERT_TRUE(os.str() == sortedClan("The North", groups));
+
+    /* The groups that joined tell only the clan they joined about changes */
+    ASSERT_TRUE(joined[2]->fight(*groups[3]) != DRAW);
+    bool traded = false;
+    for (std::size_t i = 0; i < 20 && !traded; ++i) {
+        traded = joined[4]->trade(*groups[i]);
+    }
+    ASSERT_TRUE(traded);
+    ASSERT_TRUE(hasTotals(north, groups));
+    ASSERT_TRUE(hasTotals(vale, {}));
+    ASSERT_NO_EXCEPTION(vale.addGroup(Group("Arryn", 10, 10)));
+    ASSERT_TRUE(hasTotals(vale, {vale.getGroup("Arryn")}));
+
+    /* A few groups are ranked one by one */
+    groups.push_back(vale.getGroup("Arryn"));
+    north.unite(vale, "The North");
+    ASSERT_TRUE(hasTotals(north, groups));
+    os.str("");
+    os << north;
+    ASSERT_TRUE(os.str() == sortedClan("The North", groups));
+
+    /* A new name changes the clan of every group */
+    expected.clear();
+    for (const GroupPointer& group : groups) {
+        expected.push_back(movedGroup(*group, "Westeros"));
+    }
+    Clan dorne("Dorne");
+    north.unite(dorne, "Westeros");
+    for (std::size_t i = 0; i < groups.size(); ++i) {
+        os.str("");
+        os << *groups[i];
+        ASSERT_TRUE(os.str() == expected[i]);
+    }
+    ASSERT_TRUE(hasTotals(north, groups));
+    os.str("");
+    os << north;
+    ASSERT_TRUE(os.str() == sortedClan("Westeros", groups));
+    ASSERT_TRUE(north.getStrongestGroups(1)[0] ==
+                north.getStrongestGroups(groups.size())[0]);
+
+    /* A clan that is interned after its groups joined finds them by their
+     * symbols, and unites with a clan that isn't interned */
+    Clan reach("The Reach"), riverlands("Riverlands");
+    reach.addGroup(Group("Tully", 5, 5));
+    reach.addGroup(Group("Tyrell", 10, 10));
+    reach.intern(table);
+    ASSERT_TRUE(reach.doesContain("Tully") && reach.doesContain("Tyrell"));
+    ASSERT_FALSE(reach.doesContain("Tarly"));
+    riverlands.addGroup(Group("Tarly", 5, 5));
+    riverlands.addGroup(Group("Tyrell", 1, 1));
+    ASSERT_EXCEPTION(reach.unite(riverlands, "The South"), ClanCantUnite);
+    ASSERT_EXCEPTION(riverlands.unite(reach, "The South"), ClanCantUnite);
+    *riverlands.getGroup("Tyrell") = Group("Frey", 1, 1);
+    groups = {reach.getGroup("Tully"), reach.getGroup("Tyrell"),
+              riverlands.getGroup("Tarly"), riverlands.getGroup("Frey")};
+    reach.unite(riverlands, "The South");
+    for (const GroupPointer& group : groups) {
+        ASSERT_TRUE(reach.getGroup(group->getName()) == group);
+    }
+    ASSERT_TRUE(hasTotals(reach, groups));
+
+    /* Tarly and Tully have the same power, and are ranked by their names,
+     * not by the order they were interned in */
+    os.str("");
+    os << reach;
+    ASSERT_TRUE(os.str() == sortedClan("The South", groups));
+    ASSERT_TRUE(groups[0]->getTotals().power == groups[2]->getTotals().power);
+    return true;
+}
+
 int main() {
     RUN_TEST(testClan);
+    RUN_TEST(testClanMoveGroups);
+    RUN_TEST(testClanIndex);
+    RUN_TEST(testClanTotals);
+    RUN_TEST(testClanRanking);
+    RUN_TEST(testClanUnite);
     return 0;
 }
\ No newline at end of file
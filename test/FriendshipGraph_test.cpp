@@ -0,0 +1,86 @@
+#include "../FriendshipGraph.h"
+#include "../Clan.h"
+#include "../Group.h"
+#include "../SymbolTable.h"
+#include "testMacros.h"
+
+using namespace mtm;
+
+bool testFriendshipGraph() {
+    FriendshipGraph graph;
+    graph.add(1);
+    ASSERT_TRUE(graph.contains(1) && !graph.contains(2));
+    ASSERT_TRUE(graph.areFriends(1, 1));
+    graph.makeFriends(1, 2);
+    graph.makeFriends(2, 3);
+    graph.makeFriends(4, 5);
+    ASSERT_TRUE(graph.areFriends(1, 2) && graph.areFriends(2, 1));
+    ASSERT_FALSE(graph.areFriends(1, 3));
+    ASSERT_TRUE(graph.areAllies(1, 3));
+    ASSERT_FALSE(graph.areAllies(1, 4));
+    ASSERT_FALSE(graph.areAllies(1, 6));
+    ASSERT_TRUE(graph.getAlliances().size() == 2);
+
+    /* The friends of the merged clan become friends of the other one */
+    graph.merge(4, 2);
+    ASSERT_FALSE(graph.contains(2));
+    ASSERT_TRUE(graph.areFriends(4, 1) && graph.areFriends(3, 4));
+    ASSERT_TRUE(graph.areFriends(4, 5));
+    ASSERT_FALSE(graph.areFriends(1, 2));
+    ASSERT_TRUE(graph.areAllies(1, 5));
+    ASSERT_TRUE(graph.getAlliances().size() == 1);
+    ASSERT_TRUE(graph.getAlliances()[0].size() == 4);
+
+    /* Friends that merge lose their friendship */
+    graph.merge(4, 5);
+    ASSERT_FALSE(graph.areFriends(4, 5));
+    ASSERT_TRUE(graph.getAlliances()[0].size() == 3);
+
+    /* A name used again starts a new alliance */
+    graph.add(2);
+    ASSERT_FALSE(graph.areAllies(1, 2));
+    ASSERT_TRUE(graph.getAlliances().size() == 2);
+    return true;
+}
+
+bool testClanFriendshipGraph() {
+    SymbolTable table;
+    FriendshipGraph graph;
+    Clan north("The North"), vale("The Vale"), rivers("Riverlands");
+    Clan dorne("Dorne");
+    for (Clan* clan : {&north, &vale, &rivers}) {
+        clan->intern(table);
+        clan->joinFriendships(graph);
+    }
+    north.makeFriend(vale);
+    north.makeFriend(dorne);
+    ASSERT_TRUE(graph.areFriends(table.find("The North"),
+                                 table.find("The Vale")));
+    ASSERT_TRUE(vale.isFriend(north) && north.isFriend(dorne));
+    ASSERT_TRUE(dorne.isFriend(north));
+    ASSERT_FALSE(vale.isFriend(rivers));
+
+    /* The clan of a group is checked without its clan object */
+    rivers.addGroup(Group("Tully", 10, 10));
+    vale.addGroup(Group("Arryn", 10, 10));
+    north.addGroup(Group("Stark", 10, 10));
+    ASSERT_TRUE(north.isFriend(*vale.getGroup("Arryn")));
+    ASSERT_TRUE(north.isFriend(*north.getGroup("Stark")));
+    ASSERT_FALSE(north.isFriend(*rivers.getGroup("Tully")));
+    ASSERT_TRUE(dorne.isFriend(*north.getGroup("Stark")));
+
+    /* The united clan has the friends of both, in the graph and outside */
+    rivers.unite(north, "North and Rivers");
+    ASSERT_TRUE(rivers.isFriend(vale) && vale.isFriend(rivers));
+    ASSERT_TRUE(rivers.isFriend(dorne) && dorne.isFriend(rivers));
+    ASSERT_FALSE(graph.contains(table.find("The North")));
+    ASSERT_FALSE(graph.contains(table.find("Riverlands")));
+    ASSERT_TRUE(vale.isFriend(*rivers.getGroup("Stark")));
+    return true;
+}
+
+int main(){
+    RUN_TEST(testFriendshipGraph);
+    RUN_TEST(testClanFriendshipGraph);
+    return 0;
+}
@@ -249,11 +249,117 @@ bool testTrade() {
     return true;
 }
 
+bool testCompare() {
+    Group small("Alpha", "", 1, 1, 1, 1, 50);
+    Group same_power("Beta", "", 1, 1, 1, 1, 50);
+    ASSERT_TRUE(small.compare(small) == 0);
+    ASSERT_TRUE(small.compare(same_power) < 0);
+    ASSERT_TRUE(same_power.compare(small) > 0);
+    ASSERT_TRUE(small < same_power && same_power > small);
+    ASSERT_TRUE(small != same_power);
+    ASSERT_TRUE(small == Group(small));
+
+    /* Powers that overflow int */
+    Group huge1("Huge", "", 0, 100000, 100000, 1, 100);
+    Group huge2("Huge", "", 0, 100000, 100000, 2, 100);
+    ASSERT_TRUE(huge1 < huge2);
+    ASSERT_TRUE(huge1 > small);
+    ASSERT_TRUE(huge1 != huge2);
+    return true;
+}
+
+bool testMove() {
+    Group original("A group with a name too long to be stored inline",
+                   "A clan with a name too long to be stored inline",
+                   10, 20, 30, 40, 50);
+    Group copy(original);
+    const char* name_characters = original.getName().data();
+    Group moved(std::move(original));
+    ASSERT_TRUE(moved.getName().data() == name_characters);
+    ASSERT_TRUE(moved.compare(copy) == 0);
+    ASSERT_TRUE(moved.getClan() == copy.getClan());
+    ASSERT_TRUE(moved.getSize() == 30);
+
+    Group assigned("Other", 1, 1);
+    assigned = std::move(moved);
+    ASSERT_TRUE(assigned.getName().data() == name_characters);
+    ASSERT_TRUE(assigned.compare(copy) == 0);
+    Group copied("Other", 1, 1);
+    copied = assigned;
+    ASSERT_TRUE(copied.compare(copy) == 0 && copied.getSize() == 30);
+    return true;
+}
+
+/* The default rules, but the loser loses half of its people */
+struct HarshRules : public DefaultGroupRules{
+    enum : int{
+        DIVISOR_CHILD_LOSER = 2,
+        DIVISOR_ADULT_LOSER = 2
+    };
+};
+
+/* Only food counts for power, and uniting takes more morale */
+struct FoodRules : public DefaultGroupRules{
+    enum : int{
+        TOOLS_POWER = 0,
+        MORALE_MIN_FOR_UNITE = 90
+    };
+};
+
+bool testRules() {
+    Group strong("Strong", "", 10, 10, 20, 20, 90);
+    Group weak("Weak", "", 9, 9, 20, 20, 90);
+    Group harsh_strong(strong), harsh_weak(weak);
+    ASSERT_TRUE(strong.fight(weak) == WON);
+    ASSERT_TRUE(weak.getSize() == 12);
+    ASSERT_TRUE(harsh_strong.fight<HarshRules>(harsh_weak) == WON);
+    ASSERT_TRUE(harsh_weak.getSize() == 8);
+    /* Everything else follows the default rules */
+    ASSERT_TRUE(harsh_strong.compare(strong) == 0);
+
+    /* The fight is decided, and the loser cleared, by the power of the
+     * rule set, while the cached power stays by the default rules */
+    ostringstream os;
+    Group armed("Armed", "", 1, 5, 100, 1, 80);
+    Group fed("Fed", "", 1, 6, 0, 50, 80);
+    Group food_armed(armed), food_fed(fed);
+    ASSERT_TRUE(armed.fight(fed) == WON);
+    ASSERT_TRUE(food_armed.fight<FoodRules>(food_fed) == LOST);
+    ASSERT_TRUE(food_armed.getSize() == 0);
+    ASSERT_NO_EXCEPTION(os << food_fed);
+    ASSERT_TRUE(VerifyOutput(os, "Group's name: Fed\n"
+            "Group's clan: \n"
+            "Group's children: 1\n"
+            "Group's adults: 5\n"
+            "Group's tools: 0\n"
+            "Group's food: 50\n"
+            "Group's morale: 96\n"));
+    Group same("Fed", "", 1, 5, 0, 50, 96);
+    ASSERT_TRUE(food_fed.compare(same) == 0);
+    ASSERT_TRUE(food_fed.getTotals().power == same.getTotals().power);
+
+    /* The name of the more powerful group by the rule set is kept */
+    Group armed1("Armed", "Clan", 1, 5, 100, 1, 95);
+    Group fed1("Fed", "Clan", 1, 6, 0, 50, 95);
+    Group armed2(armed1), fed2(fed1);
+    ASSERT_TRUE(armed1.unite(fed1, 100));
+    ASSERT_TRUE(armed2.unite<FoodRules>(fed2, 100));
+    ASSERT_TRUE(armed1.getName() == "Armed" && armed2.getName() == "Fed");
+    Group low1("Low", "Clan", 1, 1, 5, 5, 80);
+    Group low2("Lower", "Clan", 1, 1, 5, 5, 80);
+    ASSERT_FALSE(low1.unite<FoodRules>(low2, 100));
+    ASSERT_TRUE(low1.unite(low2, 100));
+    return true;
+}
+
 int main(){
     RUN_TEST(testGroupGeneral);
     RUN_TEST(testDivide);
     RUN_TEST(testUnite);
     RUN_TEST(testFight);
     RUN_TEST(testTrade);
+    RUN_TEST(testCompare);
+    RUN_TEST(testMove);
+    RUN_TEST(testRules);
     return 0;
 }
\ No newline at end of file
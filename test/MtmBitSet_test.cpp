@@ -0,0 +1,93 @@
+#include <type_traits>
+#include "testMacros.h"
+#include "../MtmBitSet.h"
+#include "../exceptions.h"
+
+using namespace mtm;
+
+bool isEven(int n){
+    return !(n%2);
+}
+
+bool testBitSet(){
+    /* A domain of exactly one word */
+    MtmBitSet<int, 64> set;
+    ASSERT_TRUE(set.begin() == set.end());
+    ASSERT_TRUE(*set.insert(63) == 63);
+    ASSERT_TRUE(set.begin() == set.find(63));
+    MtmBitSet<int, 64>::iterator it = set.begin();
+    ASSERT_TRUE(++it == set.end());
+    ASSERT_EXCEPTION(set.insert(64), MTMSetElementOutOfDomain);
+    for (int i = 0; i < 64; ++i) {
+        ASSERT_NO_EXCEPTION(set.insert(i));
+    }
+    ASSERT_TRUE(set.size() == 64);
+    int expected = 0;
+    for (int value : set) {
+        ASSERT_TRUE(value == expected++);
+    }
+    ASSERT_TRUE(expected == 64);
+    const MtmBitSet<int, 64>& const_set = set;
+    MtmBitSet<int, 64> evens = const_set.getSubSet(isEven);
+    ASSERT_TRUE(evens.size() == 32);
+    ASSERT_TRUE(*evens.find(62) == 62);
+    ASSERT_TRUE(evens.find(63) == evens.end());
+    ASSERT_NO_EXCEPTION(set.erase(set.find(0)));
+    ASSERT_TRUE(*set.begin() == 1);
+
+    /* The iterators return the elements by value, so nothing refers into
+     * an iterator that is gone */
+    static_assert(std::is_same<decltype(*set.begin()), int>::value,
+                  "A bit set iterator returns its elements by value");
+    const int& first = *set.begin();
+    MtmBitSet<int, 64>::iterator proxy = set.begin();
+    int taken = *proxy++;
+    ASSERT_TRUE(first == 1 && taken == 1 && *proxy == 2);
+
+    /* Whole empty words are skipped, up to the last element of the domain */
+    MtmBitSet<int, 2000> sparse;
+    ASSERT_NO_EXCEPTION(sparse.insert(1999));
+    ASSERT_NO_EXCEPTION(sparse.insert(3));
+    MtmBitSet<int, 2000>::const_iterator const_it = sparse.begin();
+    ASSERT_TRUE(*const_it == 3);
+    ASSERT_TRUE(*++const_it == 1999);
+    ASSERT_TRUE(++const_it == sparse.end());
+    ASSERT_NO_EXCEPTION(sparse.erase(3));
+    ASSERT_TRUE(*sparse.begin() == 1999);
+    ASSERT_NO_EXCEPTION(sparse.erase(1999));
+    ASSERT_TRUE(sparse.empty());
+    ASSERT_TRUE(sparse.begin() == sparse.end());
+    return true;
+}
+
+bool testBitSetDomain(){
+    MtmBitSet<int, 130> set;
+    ASSERT_EXCEPTION(set.insert(130), MTMSetElementOutOfDomain);
+    ASSERT_EXCEPTION(set.insert(-1), MTMSetElementOutOfDomain);
+    ASSERT_FALSE(set.contains(-1));
+    ASSERT_FALSE(set.contains(1000));
+    ASSERT_NO_EXCEPTION(set.erase(1000));
+    ASSERT_TRUE(set.find(130) == set.end());
+    int values[] = {0, 63, 64, 65, 127, 128, 129};
+    for (int value : values) {
+        ASSERT_NO_EXCEPTION(set.insert(value));
+    }
+    ASSERT_TRUE(set.size() == 7);
+    int i = 0;
+    for (int value : set) {
+        ASSERT_TRUE(value == values[i++]);
+    }
+    ASSERT_TRUE(i == 7);
+    MtmBitSet<unsigned char, 256> bytes;
+    ASSERT_NO_EXCEPTION(bytes.insert(255));
+    ASSERT_NO_EXCEPTION(bytes.insert(0));
+    ASSERT_TRUE(bytes.size() == 2);
+    ASSERT_TRUE(*bytes.begin() == 0);
+    return true;
+}
+
+int main(){
+    RUN_TEST(testBitSet);
+    RUN_TEST(testBitSetDomain);
+    return 0;
+}
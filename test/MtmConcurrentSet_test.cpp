@@ -0,0 +1,99 @@
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "testMacros.h"
+#include "../MtmConcurrentSet.h"
+#include "../exceptions.h"
+
+using namespace mtm;
+
+bool testConcurrentSet(){
+    MtmConcurrentSet<std::string> set;
+    ASSERT_TRUE(set.empty());
+    ASSERT_TRUE(set.insert("stark"));
+    ASSERT_FALSE(set.insert("stark"));
+    ASSERT_TRUE(set.insert("tully"));
+    ASSERT_TRUE(set.contains("stark"));
+    ASSERT_TRUE(set.size() == 2);
+    ASSERT_TRUE(set.erase("stark"));
+    ASSERT_FALSE(set.erase("stark"));
+    ASSERT_FALSE(set.contains("stark"));
+    MtmHashSet<std::string> copied = set.snapshot();
+    ASSERT_TRUE(copied.size() == 1 && copied.contains("tully"));
+    set.clear();
+    ASSERT_TRUE(set.empty());
+
+    /* Every stripe has cache lines of its own */
+    static_assert(alignof(MtmConcurrentSet<int>) == 64,
+                  "The stripes start on cache lines");
+    static_assert(sizeof(MtmConcurrentSet<int>) >= 16 * 64,
+                  "The stripes don't share cache lines");
+    ASSERT_TRUE(reinterpret_cast<std::uintptr_t>(&set) % 64 == 0);
+
+    /* An erased element is destroyed at once */
+    MtmConcurrentSet<std::shared_ptr<int> > pointers;
+    std::shared_ptr<int> pointer = std::make_shared<int>(7);
+    std::weak_ptr<int> watcher = pointer;
+    ASSERT_TRUE(pointers.insert(pointer));
+    ASSERT_TRUE(pointers.erase(pointer));
+    pointer.reset();
+    ASSERT_TRUE(watcher.expired());
+    return true;
+}
+
+/**
+ * Writers insert and erase disjoint ranges while readers query and iterate.
+ * Every writer ends by keeping its even elements, so the final contents are
+ * known.
+ */
+bool testConcurrentSetStress(){
+    const int writers = 4, readers = 4, per_writer = 2000, rounds = 3;
+    MtmConcurrentSet<int> set;
+    std::atomic<bool> done(false);
+    std::atomic<bool> reader_failed(false);
+    std::vector<std::thread> threads;
+    for (int w = 0; w < writers; ++w) {
+        threads.push_back(std::thread([&set, w]() {
+            int first = w * per_writer;
+            for (int round = 0; round < rounds; ++round) {
+                for (int i = first; i < first + per_writer; ++i) set.insert(i);
+                for (int i = first + 1; i < first + per_writer; i += 2) {
+                    set.erase(i);
+                }
+            }
+        }));
+    }
+    for (int r = 0; r < readers; ++r) {
+        threads.push_back(std::thread([&set, &done, &reader_failed]() {
+            while (!done) {
+                int count = 0;
+                set.forEach([&count, &reader_failed](int elem) {
+                    if (elem < 0 || elem >= writers * per_writer) {
+                        reader_failed = true;
+                    }
+                    ++count;
+                });
+                if (count > writers * per_writer) reader_failed = true;
+                set.contains(count);
+            }
+        }));
+    }
+    for (int w = 0; w < writers; ++w) threads[w].join();
+    done = true;
+    for (int r = 0; r < readers; ++r) threads[writers + r].join();
+    ASSERT_FALSE(reader_failed);
+    ASSERT_TRUE(set.size() == writers * per_writer / 2);
+    for (int i = 0; i < writers * per_writer; ++i) {
+        ASSERT_TRUE(set.contains(i) == (i % 2 == 0));
+    }
+    return true;
+}
+
+int main(){
+    RUN_TEST(testConcurrentSet);
+    RUN_TEST(testConcurrentSetStress);
+    return 0;
+}
@@ -0,0 +1,106 @@
+#include <string>
+#include "testMacros.h"
+#include "../MtmFlatSet.h"
+#include "../MtmSet.h"
+#include "../exceptions.h"
+
+using namespace mtm;
+
+bool isEven(int n){
+    return !(n%2);
+}
+
+bool testFlatSet(){
+    MtmFlatSet<int> set;
+    for (int i = 100; i > 0; --i) {
+        ASSERT_NO_EXCEPTION(set.insert(i));
+    }
+    ASSERT_TRUE(set.size() == 100);
+    int expected = 1;
+    for (int value : set) {
+        ASSERT_TRUE(value == expected++);
+    }
+    /* The elements around the searched one are not found */
+    ASSERT_TRUE(set.find(0) == set.end());
+    ASSERT_TRUE(set.find(101) == set.end());
+    ASSERT_TRUE(*set.insert(0) == 0);
+    ASSERT_TRUE(*set.insert(101) == 101);
+    ASSERT_TRUE(*set.begin() == 0);
+    ASSERT_NO_EXCEPTION(set.erase(set.find(50)));
+    ASSERT_FALSE(set.contains(50));
+    ASSERT_TRUE(*++set.find(49) == 51);
+    ASSERT_EXCEPTION(set.erase(set.end()), NodeIsEndException);
+    ASSERT_TRUE(set.size() == 101);
+    /* The last element, and the end after it */
+    MtmFlatSet<int>::const_iterator last = set.find(101);
+    ASSERT_TRUE(++last == set.end());
+    set.clear();
+    ASSERT_TRUE(set.begin() == set.end());
+    ASSERT_TRUE(set.find(1) == set.end());
+    return true;
+}
+
+bool testFlatSetBulk(){
+    MtmSet<std::string> names;
+    names.insert("tywin");
+    names.insert("arya");
+    names.insert("bran");
+    MtmFlatSet<std::string> flat(names.begin(), names.end());
+    ASSERT_TRUE(flat.size() == 3);
+    ASSERT_TRUE(*flat.begin() == "arya");
+    int values[] = {5, 3, 5, 1, 3, 9};
+    MtmFlatSet<int> from_array(values, values + 6);
+    ASSERT_TRUE(from_array.size() == 4);
+    int expected[] = {1, 3, 5, 9};
+    int i = 0;
+    for (int value : from_array) {
+        ASSERT_TRUE(value == expected[i++]);
+    }
+    MtmFlatSet<int, std::greater<int> > descending(values, values + 6);
+    ASSERT_TRUE(*descending.begin() == 9);
+    ASSERT_TRUE(descending.contains(3));
+    return true;
+}
+
+/**
+ * Orders ints by their remainder from a modulus that is given at runtime.
+ */
+struct ModuloLess{
+    int modulus;
+    explicit ModuloLess(int modulus = 10) : modulus(modulus) {
+    }
+    bool operator()(int first, int second) const{
+        return first % modulus < second % modulus;
+    }
+};
+
+bool testFlatSetStatefulCompare(){
+    MtmFlatSet<int, ModuloLess> set{ModuloLess(3)};
+    set.insert(4);
+    ASSERT_TRUE(*set.insert(7) == 4);
+    ASSERT_TRUE(set.size() == 1);
+    ASSERT_TRUE(set.contains(10));
+    MtmFlatSet<int, ModuloLess> other{ModuloLess(3)};
+    other.insert(5);
+    other.insert(13);
+    const MtmFlatSet<int, ModuloLess>& const_set = set;
+    /* The sets that the const functions make compare by modulo 3 too */
+    MtmFlatSet<int, ModuloLess> united = const_set.unite(other);
+    ASSERT_TRUE(united.size() == 2);
+    ASSERT_TRUE(united.contains(2) && united.contains(22));
+    ASSERT_TRUE(united == set.unite(other));
+    ASSERT_TRUE(const_set.intersect(other).contains(16));
+    MtmFlatSet<int, ModuloLess> subset = const_set.getSubSet(isEven);
+    ASSERT_TRUE(subset.contains(1));
+    int values[] = {3, 6, 9, 1};
+    MtmFlatSet<int, ModuloLess> bulk(values, values + 4, ModuloLess(3));
+    ASSERT_TRUE(bulk.size() == 2);
+    return true;
+}
+
+int main(){
+    RUN_TEST(testFlatSet);
+    RUN_TEST(testFlatSetBulk);
+    RUN_TEST(testFlatSetStatefulCompare);
+    return 0;
+}
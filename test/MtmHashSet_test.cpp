@@ -0,0 +1,234 @@
+#include <memory>
+#include <string>
+#include "testMacros.h"
+#include "../MtmHashSet.h"
+#include "../MtmString.h"
+#include "../exceptions.h"
+
+using namespace mtm;
+
+bool isEven(int n){
+    return !(n%2);
+}
+
+/**
+ * Puts all the ints in the same bucket.
+ */
+struct ConstantHash{
+    std::size_t operator()(int) const{
+        return 7;
+    }
+};
+
+bool testHashSet(){
+    /* Every element collides with all the others */
+    MtmHashSet<int, ConstantHash> set;
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_NO_EXCEPTION(set.insert(i));
+    }
+    ASSERT_TRUE(set.size() == 100);
+    ASSERT_TRUE(*set.insert(42) == 42);
+    ASSERT_TRUE(set.size() == 100);
+    /* Erasing from the middle of a collision chain keeps the rest found */
+    for (int i = 0; i < 100; i += 3) {
+        ASSERT_NO_EXCEPTION(set.erase(i));
+    }
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_TRUE(set.contains(i) == (i % 3 != 0));
+    }
+    ASSERT_TRUE(set.find(99) == set.end());
+    ASSERT_TRUE(*set.find(98) == 98);
+    const MtmHashSet<int, ConstantHash>& const_set = set;
+    MtmHashSet<int, ConstantHash> evens = const_set.getSubSet(isEven);
+    ASSERT_TRUE(evens.size() == 33);
+    ASSERT_TRUE(set.isSuperSetOf(evens));
+    ASSERT_FALSE(evens.contains(1));
+    int count = 0;
+    for (int elem : set) {
+        ASSERT_TRUE(elem % 3 != 0);
+        ++count;
+    }
+    ASSERT_TRUE(count == 66);
+    set.clear();
+    ASSERT_TRUE(set.begin() == set.end());
+    ASSERT_FALSE(set.contains(1));
+    ASSERT_NO_EXCEPTION(set.insert(1));
+    ASSERT_TRUE(*set.begin() == 1);
+    return true;
+}
+
+bool testHashSetGrowth(){
+    MtmHashSet<std::string> set;
+    const int amount = 1000;
+    for (int i = 0; i < amount; ++i) {
+        set.insert("name" + std::to_string(i));
+    }
+    ASSERT_TRUE(set.size() == amount);
+    for (int i = 0; i < amount; i += 2) {
+        set.erase("name" + std::to_string(i));
+    }
+    ASSERT_TRUE(set.size() == amount / 2);
+    for (int i = 0; i < amount; ++i) {
+        ASSERT_TRUE(set.contains("name" + std::to_string(i)) == (i % 2 == 1));
+    }
+    for (int i = 0; i < amount; ++i) {
+        set.insert("name" + std::to_string(i));
+        set.erase("name" + std::to_string(i));
+    }
+    ASSERT_TRUE(set.empty());
+    return true;
+}
+
+/**
+ * Hash and equality of ints by their remainder from 10.
+ */
+struct LastDigitHash{
+    std::size_t operator()(int n) const{
+        return std::size_t(n % 10);
+    }
+};
+
+struct LastDigitEqual{
+    bool operator()(int first, int second) const{
+        return first % 10 == second % 10;
+    }
+};
+
+bool testHashSetCustomKeys(){
+    MtmHashSet<std::string, MtmStringHash, MtmStringEqual> names;
+    names.insert("Winterfell");
+    names.insert(std::string("Riverrun"));
+    ASSERT_TRUE(names.contains("Winterfell"));
+    ASSERT_TRUE(names.contains(std::string("Riverrun")));
+    ASSERT_FALSE(names.contains("Riverrun!"));
+    const char buffer[] = "Riverrun and more";
+    ASSERT_TRUE(names.contains(MtmStringRef(buffer, 8)));
+    ASSERT_TRUE(*names.find("Winterfell") == "Winterfell");
+    ASSERT_TRUE(names.find("Dorne") == names.end());
+    const MtmHashSet<std::string, MtmStringHash, MtmStringEqual>& const_names
+            = names;
+    ASSERT_TRUE(*const_names.find(MtmStringRef("Riverrun")) == "Riverrun");
+    MtmStringHash hash;
+    ASSERT_TRUE(hash("abc") == hash(std::string("abc")));
+
+    MtmHashSet<int, LastDigitHash, LastDigitEqual> digits;
+    digits.insert(13);
+    digits.insert(23);
+    digits.insert(4);
+    ASSERT_TRUE(digits.size() == 2);
+    ASSERT_TRUE(digits.contains(3));
+    ASSERT_TRUE(*digits.find(33) == 13);
+    return true;
+}
+
+bool testHashSetStableErase(){
+    MtmHashSet<std::string> set;
+    for (int i = 0; i < 100; ++i) set.insert("name" + std::to_string(i));
+    MtmHashSet<std::string>::iterator first = set.find("name0");
+    MtmHashSet<std::string>::iterator last = set.find("name99");
+    /* Erasing other elements doesn't move the ones that are left */
+    for (int i = 1; i < 99; ++i) set.erase("name" + std::to_string(i));
+    ASSERT_TRUE(*first == "name0");
+    ASSERT_TRUE(*last == "name99");
+    ASSERT_TRUE(set.size() == 2);
+    ASSERT_TRUE(set.begin() == first);
+    MtmHashSet<std::string>::iterator it = first;
+    ASSERT_TRUE(++it == last);
+    ASSERT_TRUE(++it == set.end());
+
+    /* The erased positions are reused, and skipped while empty */
+    set.erase(first);
+    ASSERT_TRUE(set.begin() == last);
+    for (int i = 0; i < 50; ++i) set.insert("other" + std::to_string(i));
+    ASSERT_TRUE(*last == "name99");
+    ASSERT_TRUE(set.size() == 51);
+    int count = 0;
+    for (const std::string& name : set) {
+        ASSERT_TRUE(set.contains(name));
+        ++count;
+    }
+    ASSERT_TRUE(count == 51);
+    ASSERT_TRUE(set.getSubSet([](const std::string& name) {
+        return name[0] == 'o';
+    }).size() == 50);
+    ASSERT_TRUE(*set.begin() != "name99");
+    return true;
+}
+
+/**
+ * An element that counts how many of it are alive, and has no default
+ * constructor or assignment.
+ */
+struct Counted{
+    static int alive;
+    int value;
+    explicit Counted(int value) : value(value) {
+        ++alive;
+    }
+    Counted(const Counted& other) : value(other.value) {
+        ++alive;
+    }
+    Counted& operator=(const Counted&) = delete;
+    ~Counted() {
+        --alive;
+    }
+    bool operator==(const Counted& other) const {
+        return value == other.value;
+    }
+};
+int Counted::alive = 0;
+
+struct CountedHash{
+    std::size_t operator()(const Counted& counted) const {
+        return std::size_t(counted.value);
+    }
+};
+
+bool testHashSetReleases(){
+    /* An erased element is destroyed at once */
+    MtmHashSet<std::shared_ptr<int> > pointers;
+    std::shared_ptr<int> pointer = std::make_shared<int>(7);
+    std::weak_ptr<int> watcher = pointer;
+    pointers.insert(pointer);
+    pointers.insert(std::make_shared<int>(8));
+    pointer.reset();
+    ASSERT_FALSE(watcher.expired());
+    pointers.erase(*pointers.find(watcher.lock()));
+    ASSERT_TRUE(watcher.expired());
+    ASSERT_TRUE(pointers.size() == 1);
+
+    {
+        MtmHashSet<Counted, CountedHash> set;
+        for (int i = 0; i < 100; ++i) set.insert(Counted(i));
+        ASSERT_TRUE(Counted::alive == 100);
+        for (int i = 0; i < 100; i += 2) set.erase(Counted(i));
+        ASSERT_TRUE(Counted::alive == 50);
+        set.getSubSet([](const Counted& counted) {
+            return counted.value % 3 == 0;
+        });
+        ASSERT_TRUE(Counted::alive == set.size());
+        MtmHashSet<Counted, CountedHash> copied(set);
+        ASSERT_TRUE(Counted::alive == 2 * set.size());
+        for (int i = 0; i < 100; ++i) copied.insert(Counted(i));
+        ASSERT_TRUE(Counted::alive == set.size() + 100);
+        copied = set;
+        ASSERT_TRUE(Counted::alive == 2 * set.size());
+        ASSERT_TRUE(copied == set);
+        MtmHashSet<Counted, CountedHash> moved(std::move(copied));
+        ASSERT_TRUE(Counted::alive == 2 * set.size());
+        ASSERT_TRUE(copied.empty() && moved == set);
+        moved.clear();
+        ASSERT_TRUE(Counted::alive == set.size());
+    }
+    ASSERT_TRUE(Counted::alive == 0);
+    return true;
+}
+
+int main(){
+    RUN_TEST(testHashSet);
+    RUN_TEST(testHashSetGrowth);
+    RUN_TEST(testHashSetCustomKeys);
+    RUN_TEST(testHashSetStableErase);
+    RUN_TEST(testHashSetReleases);
+    return 0;
+}
@@ -0,0 +1,117 @@
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include "testMacros.h"
+#include "../MtmParallel.h"
+#include "../MtmSet.h"
+#include "../exceptions.h"
+
+using namespace mtm;
+
+bool isEven(int n){
+    return !(n%2);
+}
+
+bool hasEvenLength(const std::string& name){
+    return name.size() % 2 == 0;
+}
+
+/**
+ * Check that two sets have the same elements in the same order.
+ */
+template<typename Set>
+bool sameOrder(const Set& set1, const Set& set2){
+    typename Set::const_iterator it1 = set1.begin();
+    typename Set::const_iterator it2 = set2.begin();
+    for ( ; it1 != set1.end() && it2 != set2.end(); ++it1, ++it2) {
+        if (!(*it1 == *it2)) return false;
+    }
+    return it1 == set1.end() && it2 == set2.end();
+}
+
+bool testParallelSetAlgebra(){
+    MtmSet<int> set1;
+    MtmSet<int> set2;
+    for (int i = 0; i < 1000; ++i) set1.insert((i * 7) % 1000);
+    for (int i = 500; i < 1500; i += 3) set2.insert(i);
+    const MtmSet<int>& const_set1 = set1;
+    unsigned thread_counts[] = {1, 2, 3, 8};
+    for (unsigned threads : thread_counts) {
+        ASSERT_TRUE(sameOrder(parallelUnite(set1, set2, threads),
+                              const_set1.unite(set2)));
+        ASSERT_TRUE(sameOrder(parallelIntersect(set1, set2, threads),
+                              const_set1.intersect(set2)));
+        ASSERT_TRUE(sameOrder(parallelGetSubSet(set1, isEven, threads),
+                              const_set1.getSubSet(isEven)));
+        ASSERT_FALSE(parallelIsSuperSetOf(set1, set2, threads));
+        ASSERT_TRUE(parallelIsSuperSetOf(set1,
+                                         const_set1.intersect(set2), threads));
+    }
+    MtmSet<int> empty_set;
+    ASSERT_TRUE(parallelUnite(empty_set, set2) == set2);
+    ASSERT_TRUE(parallelIntersect(set1, empty_set).empty());
+    ASSERT_TRUE(parallelIsSuperSetOf(empty_set, empty_set));
+    return true;
+}
+
+bool testParallelStrings(){
+    MtmSet<std::string> names1;
+    MtmSet<std::string> names2;
+    for (int i = 0; i < 300; ++i) {
+        names1.insert("group" + std::to_string(i));
+        names2.insert("group" + std::to_string(i * 2));
+    }
+    const MtmSet<std::string>& const_names1 = names1;
+    ASSERT_TRUE(sameOrder(parallelUnite(names1, names2, 4),
+                          const_names1.unite(names2)));
+    ASSERT_TRUE(parallelIntersect(names1, names2, 4).size() == 150);
+    ASSERT_EXCEPTION(parallelGetSubSet(names1, [](const std::string& name) {
+        if (name == "group250") throw std::runtime_error("condition");
+        return true;
+    }, 4), std::runtime_error);
+    return true;
+}
+
+bool testParallelThreshold(){
+    const std::size_t min_work = parallel::MIN_WORK_PER_THREAD;
+    /* Small work stays on the calling thread, whatever was asked for */
+    ASSERT_TRUE(parallel::rangeCount(1000, 300, 8) == 1);
+    ASSERT_TRUE(parallel::rangeCount(0, min_work, 8) == 1);
+    ASSERT_TRUE(parallel::rangeCount(1000, 0, 8) == 1);
+    /* Larger work gets a thread per MIN_WORK_PER_THREAD, up to the limit */
+    ASSERT_TRUE(parallel::rangeCount(8, min_work / 4, 8) == 2);
+    ASSERT_TRUE(parallel::rangeCount(100, min_work, 8) == 8);
+    ASSERT_TRUE(parallel::rangeCount(3, min_work, 8) == 3);
+    ASSERT_TRUE(parallel::rangeCount(100, min_work, 1) == 1);
+
+    std::atomic<int> ranges(0);
+    std::atomic<int> covered(0);
+    parallel::forEachRange(100, min_work, 4,
+                           [&](std::size_t first, std::size_t last) {
+        ++ranges;
+        covered += int(last - first);
+    });
+    ASSERT_TRUE(ranges == 4);
+    ASSERT_TRUE(covered == 100);
+
+    /* A costly condition runs on several threads, and its exception in
+     * another thread still reaches the caller */
+    MtmSet<std::string> names;
+    for (int i = 0; i < 300; ++i) names.insert("group" + std::to_string(i));
+    const MtmSet<std::string>& const_names = names;
+    ASSERT_EXCEPTION(parallelGetSubSet(names, [](const std::string& name) {
+        if (name == "group250") throw std::runtime_error("condition");
+        return true;
+    }, 4, min_work), std::runtime_error);
+    ASSERT_TRUE(sameOrder(parallelGetSubSet(names, hasEvenLength, 4,
+                                            min_work),
+                          const_names.getSubSet(hasEvenLength)));
+    return true;
+}
+
+int main(){
+    RUN_TEST(testParallelSetAlgebra);
+    RUN_TEST(testParallelStrings);
+    RUN_TEST(testParallelThreshold);
+    return 0;
+}
@@ -0,0 +1,85 @@
+#include "testMacros.h"
+#include "../MtmPersistentSet.h"
+#include "../exceptions.h"
+
+using namespace mtm;
+
+bool isEven(int n){
+    return !(n%2);
+}
+
+bool testPersistentSet(){
+    MtmPersistentSet<int> set;
+    for (int i = 0; i < 10; ++i) {
+        ASSERT_NO_EXCEPTION(set.insert(i));
+    }
+    /* An iterator of a set survives the changes of its copies */
+    const MtmPersistentSet<int> snapshot(set);
+    MtmPersistentSet<int>::const_iterator it = snapshot.find(4);
+    MtmPersistentSet<int> copy(snapshot);
+    for (int i = 0; i < 10; ++i) {
+        ASSERT_NO_EXCEPTION(copy.erase(i));
+        ASSERT_NO_EXCEPTION(set.insert(i + 100));
+    }
+    ASSERT_TRUE(copy.empty());
+    ASSERT_TRUE(copy.begin() == copy.end());
+    ASSERT_TRUE(*it == 4);
+    ASSERT_TRUE(*++it == 5);
+    int expected = 5;
+    for (; it != snapshot.end(); ++it) {
+        ASSERT_TRUE(*it == expected++);
+    }
+    ASSERT_TRUE(expected == 10);
+
+    ASSERT_NO_EXCEPTION(copy.unite(snapshot));
+    ASSERT_TRUE(copy == snapshot);
+    ASSERT_TRUE(*copy.find(4) == 4);
+    ASSERT_TRUE(set.size() == 20);
+    ASSERT_TRUE(set.isSuperSetOf(snapshot));
+    ASSERT_TRUE(*set.find(9) == 9);
+    ASSERT_TRUE(*++set.find(9) == 100);
+    return true;
+}
+
+bool testPersistentSetSnapshot(){
+    MtmPersistentSet<int> set;
+    for (int i = 0; i < 1000; ++i) {
+        ASSERT_NO_EXCEPTION(set.insert((i * 37) % 1000));
+    }
+    const MtmPersistentSet<int> snapshot(set);
+    ASSERT_TRUE(snapshot == set);
+    for (int i = 0; i < 1000; i += 2) {
+        ASSERT_NO_EXCEPTION(set.erase(i));
+    }
+    ASSERT_NO_EXCEPTION(set.insert(5000));
+    ASSERT_TRUE(set.size() == 501);
+    ASSERT_TRUE(snapshot.size() == 1000);
+    ASSERT_TRUE(snapshot.contains(0));
+    ASSERT_FALSE(snapshot.contains(5000));
+    ASSERT_FALSE(set.contains(0));
+    int expected = 0;
+    for (int value : snapshot) {
+        ASSERT_TRUE(value == expected++);
+    }
+    ASSERT_TRUE(expected == 1000);
+    expected = 1;
+    for (int value : set) {
+        ASSERT_TRUE(value == (expected < 1000 ? expected : 5000));
+        expected += 2;
+    }
+    MtmPersistentSet<int> odd = snapshot.getSubSet(
+            [](int n) { return n % 2 == 1; });
+    ASSERT_TRUE(odd.size() == 500);
+    ASSERT_TRUE(set.isSuperSetOf(odd));
+    ASSERT_TRUE(snapshot.isSuperSetOf(odd));
+    ASSERT_FALSE(odd.isSuperSetOf(set));
+    odd.clear();
+    ASSERT_TRUE(snapshot.size() == 1000);
+    return true;
+}
+
+int main(){
+    RUN_TEST(testPersistentSet);
+    RUN_TEST(testPersistentSetSnapshot);
+    return 0;
+}
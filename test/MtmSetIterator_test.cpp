@@ -0,0 +1,91 @@
+#include "testMacros.h"
+#include "../MtmFlatSet.h"
+#include "../MtmHashSet.h"
+#include "../MtmBitSet.h"
+#include "../MtmPersistentSet.h"
+#include "../exceptions.h"
+
+using namespace mtm;
+
+bool isEven(int n){
+    return !(n%2);
+}
+
+/**
+ * The interface that all the sets of MtmSetIterator share with MtmSet.
+ * The hash set has no order, so only the ordered sets check it.
+ */
+template<typename Set>
+bool testSetInterface(bool ordered){
+    Set set;
+    ASSERT_TRUE(set.begin() == set.end());
+    ASSERT_TRUE(set.empty());
+    ASSERT_EXCEPTION(*set.begin(), NodeIsEndException);
+    ASSERT_NO_EXCEPTION(set.insert(2));
+    ASSERT_NO_EXCEPTION(set.insert(1));
+    ASSERT_TRUE(*set.insert(2) == 2);
+    ASSERT_TRUE(set.size() == 2);
+    if (ordered) ASSERT_TRUE(*set.begin() == 1);
+    Set set2(set);
+    ASSERT_NO_EXCEPTION(set.erase(1));
+    ASSERT_FALSE(set.contains(1));
+    ASSERT_TRUE(set2.contains(1));
+    typename Set::iterator it = set.begin();
+    ASSERT_TRUE(*(it++) == 2);
+    ASSERT_TRUE(it == set.end());
+    ASSERT_EXCEPTION(*it, NodeIsEndException);
+    ASSERT_EXCEPTION(++it, NodeIsEndException);
+    ASSERT_EXCEPTION(it++, NodeIsEndException);
+    ASSERT_TRUE(set.begin() == set.find(2));
+    ASSERT_TRUE(set.find(7) == set.end());
+    ASSERT_TRUE(set2.isSuperSetOf(set));
+    ASSERT_TRUE(set2 != set);
+    ASSERT_NO_EXCEPTION(set.unite(set2));
+    ASSERT_TRUE(set == set2);
+    Set empty_set;
+    ASSERT_NO_EXCEPTION(set.intersect(empty_set));
+    ASSERT_TRUE(set.empty());
+
+    ASSERT_NO_EXCEPTION(set.insert(17));
+    ASSERT_NO_EXCEPTION(set.insert(32));
+    ASSERT_NO_EXCEPTION(set.insert(1));
+    ASSERT_NO_EXCEPTION(set.insert(2));
+    const Set const_set(set);
+    Set set3 = const_set.getSubSet(isEven);
+    ASSERT_TRUE(set3.size() == 2);
+    ASSERT_TRUE(const_set.unite(set3) == const_set);
+    ASSERT_TRUE(const_set.intersect(set3) == set3);
+    ASSERT_FALSE(set3.isSuperSetOf(set));
+
+    /* An iterator converts to a const_iterator, and they compare */
+    typename Set::const_iterator const_it = set.find(17);
+    ASSERT_TRUE(const_it == set.find(17));
+    ASSERT_TRUE(set.find(17) == const_it);
+    ASSERT_TRUE(const_it != set.find(32));
+    ASSERT_TRUE(typename Set::const_iterator() == const_set.end());
+    ASSERT_TRUE(typename Set::iterator() == set.end());
+    int count = 0;
+    int previous = -1;
+    for (const_it = const_set.begin(); const_it != const_set.end();
+         ++const_it) {
+        ASSERT_TRUE(set.contains(*const_it));
+        if (ordered) ASSERT_TRUE(previous < *const_it);
+        previous = *const_it;
+        ++count;
+    }
+    ASSERT_TRUE(count == 4);
+    return true;
+}
+
+bool testIterators(){
+    ASSERT_TRUE(testSetInterface<MtmFlatSet<int> >(true));
+    ASSERT_TRUE(testSetInterface<MtmHashSet<int> >(false));
+    ASSERT_TRUE((testSetInterface<MtmBitSet<int, 2000> >(true)));
+    ASSERT_TRUE(testSetInterface<MtmPersistentSet<int> >(true));
+    return true;
+}
+
+int main(){
+    RUN_TEST(testIterators);
+    return 0;
+}
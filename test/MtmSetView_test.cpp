@@ -0,0 +1,91 @@
+#include <string>
+#include "testMacros.h"
+#include "../MtmSetView.h"
+#include "../MtmHashSet.h"
+#include "../MtmBitSet.h"
+#include "../MtmSet.h"
+#include "../exceptions.h"
+
+using namespace mtm;
+
+bool isEven(int n){
+    return !(n%2);
+}
+
+bool testSetView(){
+    MtmSet<int> odd;
+    MtmSet<int> small;
+    for (int i = 1; i < 10; i += 2) odd.insert(i);
+    for (int i = 0; i < 4; ++i) small.insert(i);
+    const MtmSet<int>& const_odd = odd;
+    const MtmSet<int>& const_small = small;
+
+    ASSERT_TRUE(view(odd).size() == 5);
+    ASSERT_TRUE(view(odd).unite(small).size() == 7);
+    ASSERT_TRUE(view(odd).intersect(small).size() == 2);
+    ASSERT_TRUE(view(odd).getSubSet(isEven).empty());
+    ASSERT_TRUE(view(small).getSubSet(isEven).size() == 2);
+    ASSERT_TRUE(view(odd).unite(small).contains(0));
+    ASSERT_FALSE(view(odd).intersect(small).contains(5));
+    ASSERT_FALSE(view(small).getSubSet(isEven).contains(1));
+
+    ASSERT_TRUE(view(odd).unite(small).materialize()
+                == const_odd.unite(small));
+    ASSERT_TRUE(view(odd).intersect(small).materialize()
+                == const_odd.intersect(small));
+    ASSERT_TRUE(view(small).getSubSet(isEven).materialize()
+                == const_small.getSubSet(isEven));
+
+    /* Composed views */
+    MtmSet<int> even_union = view(odd).unite(small).getSubSet(isEven)
+            .materialize();
+    ASSERT_TRUE(even_union.size() == 2);
+    ASSERT_TRUE(even_union.contains(0) && even_union.contains(2));
+    ASSERT_TRUE(view(odd).unite(view(small).getSubSet(isEven)).size() == 7);
+    auto nested = view(small).intersect(view(odd).unite(small));
+    ASSERT_TRUE(nested.materialize() == small);
+
+    /* The union lists the left operand first, then what it lacks */
+    int expected[] = {0, 1, 2, 3, 5, 7, 9};
+    int i = 0;
+    for (int value : view(small).unite(odd)) {
+        ASSERT_TRUE(value == expected[i++]);
+    }
+    ASSERT_TRUE(i == 7);
+
+    auto it = view(small).intersect(odd).end();
+    ASSERT_EXCEPTION(*it, NodeIsEndException);
+    return true;
+}
+
+bool testSetViewOtherSets(){
+    MtmHashSet<std::string> hashed;
+    hashed.insert("arya");
+    hashed.insert("bran");
+    MtmSet<std::string> listed;
+    listed.insert("bran");
+    listed.insert("sansa");
+    ASSERT_TRUE(view(hashed).unite(listed).size() == 3);
+    ASSERT_TRUE(view(listed).intersect(hashed).size() == 1);
+    MtmHashSet<std::string> united = view(hashed).unite(listed)
+            .materialize<MtmHashSet<std::string> >();
+    ASSERT_TRUE(united.size() == 3);
+    ASSERT_TRUE(united.contains("sansa"));
+
+    /* The elements of a bit set are copies, and views pass them on */
+    MtmBitSet<int, 100> bits;
+    bits.insert(3);
+    bits.insert(42);
+    MtmSet<int> numbers;
+    numbers.insert(42);
+    numbers.insert(7);
+    ASSERT_TRUE(view(bits).unite(numbers).size() == 3);
+    ASSERT_TRUE(*view(bits).getSubSet(isEven).begin() == 42);
+    return true;
+}
+
+int main(){
+    RUN_TEST(testSetView);
+    RUN_TEST(testSetViewOtherSets);
+    return 0;
+}
@@ -1,3 +1,4 @@
+#include <string>
 #include "testMacros.h"
 #include "../MtmSet.h"
 #include "../exceptions.h"
@@ -65,7 +66,136 @@ bool testSet(){
     return true;
 }
 
+bool testSetCopyAndClear(){
+    MtmSet<std::string> set;
+    for (int i = 0; i < 100; ++i) {
+        set.insert("group" + std::to_string(i));
+    }
+    MtmSet<std::string> copied(set);
+    ASSERT_TRUE(copied.size() == 100);
+    ASSERT_TRUE(copied == set);
+    MtmSet<std::string> assigned;
+    assigned.insert("old");
+    assigned = set;
+    ASSERT_TRUE(assigned.size() == 100);
+    ASSERT_FALSE(assigned.contains("old"));
+    assigned = assigned;
+    ASSERT_TRUE(assigned == set);
+    MtmSet<std::string>::iterator kept = set.find("group99");
+    for (int i = 0; i < 100; i += 2) {
+        set.erase("group" + std::to_string(i));
+    }
+    for (int i = 0; i < 50; ++i) {
+        set.insert("again" + std::to_string(i));
+    }
+    ASSERT_TRUE(set.size() == 100);
+    /* Pooled nodes are reused from a free list, never moved */
+    ASSERT_TRUE(*kept == "group99");
+    ASSERT_TRUE(set.find("group99") == kept);
+    ASSERT_TRUE(set.contains("group1") && set.contains("again49"));
+    set.clear();
+    ASSERT_TRUE(set.empty());
+    ASSERT_TRUE(set.begin() == set.end());
+    set.insert("after clear");
+    ASSERT_TRUE(set.size() == 1);
+    MtmSet<int> numbers;
+    for (int i = 0; i < 100; ++i) numbers.insert(i);
+    numbers.clear();
+    ASSERT_TRUE(numbers.empty());
+    numbers.insert(3);
+    ASSERT_TRUE(*numbers.begin() == 3);
+    return true;
+}
+
+bool testSetMove(){
+    MtmSet<std::string> set;
+    set.insert("stark");
+    std::string name("lannister");
+    set.insert(std::move(name));
+    ASSERT_TRUE(set.contains("lannister"));
+    ASSERT_TRUE(*set.emplace(5, 'a') == "aaaaa");
+    ASSERT_TRUE(set.emplace("stark") == set.find("stark"));
+    ASSERT_TRUE(set.size() == 3);
+    MtmSet<std::string> moved(std::move(set));
+    ASSERT_TRUE(moved.size() == 3);
+    ASSERT_TRUE(set.empty());
+    ASSERT_TRUE(set.begin() == set.end());
+    set.insert("reused");
+    ASSERT_TRUE(set.size() == 1);
+    MtmSet<std::string> assigned;
+    assigned.insert("old");
+    assigned = std::move(moved);
+    ASSERT_TRUE(assigned.size() == 3);
+    ASSERT_FALSE(assigned.contains("old"));
+    MtmSet<std::string> united = MtmSet<std::string>(assigned).unite(set);
+    ASSERT_TRUE(united.size() == 4);
+    MtmSet<std::string> intersected =
+            MtmSet<std::string>(united).intersect(set);
+    ASSERT_TRUE(intersected.size() == 1);
+    ASSERT_TRUE(intersected.contains("reused"));
+    MtmSet<std::string> subset = std::move(united).getSubSet(
+            [](const std::string& str) { return str.size() == 5; });
+    ASSERT_TRUE(subset.size() == 2);
+    ASSERT_TRUE(subset.contains("stark") && subset.contains("aaaaa"));
+    return true;
+}
+
+bool testSetInline(){
+    typedef MtmSet<std::string, 4> SmallSet;
+    SmallSet set;
+    for (int i = 0; i < 3; ++i) set.insert("inline" + std::to_string(i));
+    ASSERT_TRUE(set.size() == 3);
+    for (int i = 0; i < 10; ++i) set.insert("spill" + std::to_string(i));
+    ASSERT_TRUE(set.size() == 13);
+    ASSERT_TRUE(*set.begin() == "inline0");
+    set.erase("inline1");
+    set.erase("spill5");
+    ASSERT_TRUE(set.size() == 11);
+    SmallSet copied(set);
+    ASSERT_TRUE(copied == set);
+    SmallSet moved(std::move(copied));
+    ASSERT_TRUE(moved == set);
+    ASSERT_TRUE(copied.empty());
+    copied.insert("reused");
+    ASSERT_TRUE(copied.size() == 1);
+    copied = std::move(moved);
+    ASSERT_TRUE(copied == set);
+    SmallSet::const_iterator it = copied.begin();
+    int count = 0;
+    for ( ; it != copied.end(); ++it) ++count;
+    ASSERT_TRUE(count == 11);
+    set.clear();
+    ASSERT_TRUE(set.empty());
+    set.insert("after clear");
+    ASSERT_TRUE(set.contains("after clear"));
+    ASSERT_TRUE(set.unite(copied).size() == 12);
+    return true;
+}
+
+bool testSetIterationPolicy(){
+    MtmSet<int, 0, MtmCheckedIteration> checked;
+    MtmSet<int, 0, MtmUncheckedIteration> unchecked;
+    for (int i = 0; i < 10; ++i) {
+        checked.insert(i);
+        unchecked.insert(i);
+    }
+    int checked_sum = 0;
+    for (int value : checked) checked_sum += value;
+    int unchecked_sum = 0;
+    for (int value : unchecked) unchecked_sum += value;
+    ASSERT_TRUE(checked_sum == 45 && unchecked_sum == 45);
+    ASSERT_TRUE(*unchecked.find(7) == 7);
+    ASSERT_TRUE(unchecked.find(10) == unchecked.end());
+    ASSERT_EXCEPTION(*checked.end(), NodeIsEndException);
+    ASSERT_EXCEPTION(++checked.end(), NodeIsEndException);
+    return true;
+}
+
 int main(){
     RUN_TEST(testSet);
+    RUN_TEST(testSetCopyAndClear);
+    RUN_TEST(testSetMove);
+    RUN_TEST(testSetInline);
+    RUN_TEST(testSetIterationPolicy);
     return 0;
 }
@@ -0,0 +1,124 @@
+#include <climits>
+#include "../PackedGroup.h"
+#include "../Group.h"
+#include "../exceptions.h"
+#include "testMacros.h"
+
+using namespace mtm;
+
+/**
+ * Checks that a packed group is the same as a group, by printing both.
+ */
+static bool isSame(const PackedGroup& packed, const Group& group,
+                   SymbolTable& table) {
+    Group unpacked("Unpacked", 1, 1);
+    packed.unpackTo(unpacked, table);
+    ostringstream packed_os, group_os;
+    packed_os << unpacked;
+    group_os << group;
+    return packed_os.str() == group_os.str();
+}
+
+bool testPackUnpack() {
+    ASSERT_TRUE(sizeof(PackedGroup) <= 32);
+    SymbolTable table;
+    Group stark("Stark", "The North", 20, 30, 40, 50, 80);
+    PackedGroup packed(stark, table);
+    ASSERT_TRUE(isSame(packed, stark, table));
+    ASSERT_TRUE(packed.getNameSymbol() == table.find("Stark"));
+    ASSERT_TRUE(packed.getClanSymbol() == table.find("The North"));
+    ASSERT_TRUE(packed.getSize() == 50);
+
+    Group unpacked("Other", 1, 1);
+    packed.unpackTo(unpacked, table);
+    ASSERT_TRUE(unpacked.getNameSymbol() == packed.getNameSymbol());
+    ASSERT_TRUE(unpacked == stark);
+    ASSERT_TRUE(isSame(packed, unpacked, table));
+    return true;
+}
+
+bool testPackedFight() {
+    SymbolTable table;
+    Group stark("Stark", "The North", 20, 30, 40, 50, 80);
+    Group lannister("Lannister", "Lannister", 10, 40, 60, 30, 90);
+    Group tully("Tully", "Riverlands", 20, 30, 40, 50, 80);
+    PackedGroup packed_stark(stark, table);
+    PackedGroup packed_lannister(lannister, table);
+    PackedGroup packed_tully(tully, table);
+    ASSERT_TRUE((packed_stark.compare(packed_lannister, table) < 0)
+                == (stark < lannister));
+    ASSERT_TRUE((packed_stark.compare(packed_tully, table) < 0)
+                == (stark < tully));
+    ASSERT_TRUE(packed_stark.compare(packed_stark, table) == 0);
+
+    /* Fight until one of the groups is empty */
+    while (stark.getSize() > 0 && lannister.getSize() > 0) {
+        ASSERT_TRUE(packed_stark.fight(packed_lannister, table)
+                    == stark.fight(lannister));
+        ASSERT_TRUE(isSame(packed_stark, stark, table));
+        ASSERT_TRUE(isSame(packed_lannister, lannister, table));
+    }
+    ASSERT_EXCEPTION(packed_stark.fight(packed_stark, table),
+                     GroupCantFightWithItself);
+    ASSERT_EXCEPTION(packed_stark.fight(packed_lannister, table),
+                     GroupCantFightEmptyGroup);
+    return true;
+}
+
+bool testPackedUniteAndTrade() {
+    SymbolTable table;
+    Group stark("Stark", "The North", 20, 30, 40, 10, 80);
+    Group bolton("Bolton", "The North", 10, 30, 5, 60, 75);
+    Group arryn("Arryn", "The Vale", 10, 30, 5, 60, 90);
+    PackedGroup packed_stark(stark, table);
+    PackedGroup packed_bolton(bolton, table);
+    PackedGroup packed_arryn(arryn, table);
+
+    ASSERT_TRUE(packed_stark.trade(packed_bolton) == stark.trade(bolton));
+    ASSERT_TRUE(isSame(packed_stark, stark, table));
+    ASSERT_TRUE(isSame(packed_bolton, bolton, table));
+    ASSERT_TRUE(packed_stark.trade(packed_bolton) == stark.trade(bolton));
+    ASSERT_EXCEPTION(packed_stark.trade(packed_stark),
+                     GroupCantTradeWithItself);
+
+    ASSERT_FALSE(packed_stark.unite(packed_arryn, 1000));
+    ASSERT_FALSE(packed_stark.unite(packed_bolton, 50));
+    ASSERT_FALSE(packed_stark.unite(packed_stark, 1000));
+    ASSERT_TRUE(packed_stark.unite(packed_bolton, 1000)
+                == stark.unite(bolton, 1000));
+    ASSERT_TRUE(isSame(packed_stark, stark, table));
+    ASSERT_TRUE(isSame(packed_bolton, bolton, table));
+    return true;
+}
+
+bool testPackedOverflow() {
+    SymbolTable table;
+    Group big("Big", "Clan", 1, 1, INT_MAX - 10, 1, 80);
+    Group rich("Rich", "Clan", 1, 1, 20, INT_MAX - 10, 80);
+    Group tight("Tight", "Clan", 1, 1, INT_MAX, INT_MAX - 5, 80);
+    Group fed("Fed", "Clan", 1, 1, 0, 100, 80);
+    PackedGroup packed_big(big, table);
+    PackedGroup packed_rich(rich, table);
+    PackedGroup packed_tight(tight, table);
+    PackedGroup packed_fed(fed, table);
+
+    /* A failed operation doesn't change either group */
+    ASSERT_EXCEPTION(packed_big.unite(packed_rich, 1000), GroupOverflow);
+    ASSERT_TRUE(isSame(packed_big, big, table));
+    ASSERT_TRUE(isSame(packed_rich, rich, table));
+    ASSERT_EXCEPTION(packed_rich.trade(packed_tight), GroupOverflow);
+    ASSERT_TRUE(isSame(packed_rich, rich, table));
+    ASSERT_TRUE(isSame(packed_tight, tight, table));
+    ASSERT_EXCEPTION(packed_rich.fight(packed_fed, table), GroupOverflow);
+    ASSERT_TRUE(isSame(packed_rich, rich, table));
+    ASSERT_TRUE(isSame(packed_fed, fed, table));
+    return true;
+}
+
+int main(){
+    RUN_TEST(testPackUnpack);
+    RUN_TEST(testPackedFight);
+    RUN_TEST(testPackedUniteAndTrade);
+    RUN_TEST(testPackedOverflow);
+    return 0;
+}
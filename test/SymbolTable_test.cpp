@@ -0,0 +1,96 @@
+#include "../SymbolTable.h"
+#include "../Clan.h"
+#include "../Group.h"
+#include "../exceptions.h"
+#include "testMacros.h"
+
+using namespace mtm;
+
+bool testSymbolTable() {
+    SymbolTable table;
+    ASSERT_TRUE(table.size() == 1);
+    ASSERT_TRUE(table.find("") == SymbolTable::EMPTY);
+    ASSERT_TRUE(table.name(SymbolTable::EMPTY).empty());
+
+    SymbolTable::Symbol stark = table.intern("Stark");
+    SymbolTable::Symbol bolton = table.intern("Bolton");
+    ASSERT_TRUE(stark != bolton && stark != SymbolTable::EMPTY);
+    ASSERT_TRUE(table.intern(std::string("Stark")) == stark);
+    ASSERT_TRUE(table.find("Bolton") == bolton);
+    ASSERT_TRUE(table.find("Tully") == SymbolTable::NOT_FOUND);
+    ASSERT_TRUE(table.size() == 3);
+
+    /* The names stay in place while the table grows */
+    const std::string& name = table.name(stark);
+    for (int i = 0; i < 1000; ++i) table.intern(std::to_string(i));
+    ASSERT_TRUE(&table.name(stark) == &name && name == "Stark");
+    ASSERT_TRUE(table.size() == 1003);
+    return true;
+}
+
+bool testInternedGroups() {
+    SymbolTable table;
+    Group stark("Stark", "The North", 20, 30, 40, 50, 80);
+    Group bolton("Bolton", "The North", 10, 30, 40, 50, 80);
+    Group arryn("Arryn", "The Vale", 10, 30, 40, 50, 80);
+    Group plain("Bolton", "The North", 10, 30, 40, 50, 80);
+    stark.intern(table);
+    bolton.intern(table);
+    arryn.intern(table);
+    ASSERT_TRUE(stark.getName() == "Stark");
+    ASSERT_TRUE(stark.getClan() == "The North");
+    ASSERT_TRUE(stark.getNameSymbol() == table.find("Stark"));
+    ASSERT_TRUE(plain.getNameSymbol() == SymbolTable::NOT_FOUND);
+    ASSERT_TRUE(stark.hasSameClan(bolton));
+    ASSERT_FALSE(stark.hasSameClan(arryn));
+    /* Groups from a table and groups without one still compare */
+    ASSERT_TRUE(plain.hasSameClan(bolton) && bolton.hasSameClan(plain));
+    ASSERT_TRUE(plain.compare(bolton) == 0 && bolton == plain);
+
+    /* New names and clans go through the table */
+    arryn.changeClan("The North");
+    ASSERT_TRUE(arryn.hasSameClan(stark));
+    Group divided = stark.divide("Stark_2");
+    ASSERT_TRUE(divided.getNameSymbol() == table.find("Stark_2"));
+    ASSERT_TRUE(divided.hasSameClan(stark));
+    /* The weaker group takes the name of the stronger one */
+    ASSERT_TRUE(stark.unite(bolton, 1000));
+    ASSERT_TRUE(stark.getName() == "Bolton" && bolton.getSize() == 0);
+    ASSERT_TRUE(bolton.getName().empty() && bolton.getClan().empty());
+
+    ostringstream os;
+    os << stark;
+    ASSERT_TRUE(os.str().find("Group's name: Bolton\n") == 0);
+    return true;
+}
+
+bool testInternedClan() {
+    SymbolTable table;
+    Clan north("The North");
+    north.addGroup(Group("Stark", 20, 30));
+    north.intern(table);
+    north.addGroup(Group("Bolton", 10, 30));
+    ASSERT_TRUE(north.doesContain("Stark") && north.doesContain("Bolton"));
+    ASSERT_FALSE(north.doesContain("Tully"));
+    ASSERT_TRUE(north.getGroup("Bolton")->getClan() == "The North");
+    ASSERT_EXCEPTION(north.addGroup(Group("Stark", 1, 1)),
+                     ClanGroupNameAlreadyTaken);
+    ASSERT_EXCEPTION(north.getGroup("Tully"), ClanGroupNotFound);
+
+    /* Groups of a clan without a table join the table when united */
+    Clan riverlands("Riverlands");
+    riverlands.addGroup(Group("Tully", 10, 30));
+    north.unite(riverlands, "North and Rivers");
+    ASSERT_TRUE(north.doesContain("Tully"));
+    ASSERT_TRUE(north.getGroup("Tully")->getNameSymbol()
+                == table.find("Tully"));
+    ASSERT_TRUE(north.getGroup("Stark")->getClan() == "North and Rivers");
+    return true;
+}
+
+int main(){
+    RUN_TEST(testSymbolTable);
+    RUN_TEST(testInternedGroups);
+    RUN_TEST(testInternedClan);
+    return 0;
+}
@@ -249,7 +249,35 @@ bool testWorld(){
     return true;
 }
 
+bool testWorldAlliances(){
+    World w;
+    fillWorld(w);
+    ASSERT_TRUE(w.areAllies("Asgarnia", "Newbie"));
+    ASSERT_TRUE(w.areAllies("Crandor", "Crandor"));
+    ASSERT_FALSE(w.areAllies("Asgarnia", "Crandor"));
+    ASSERT_EXCEPTION(w.areAllies("Asgarnia", "Camelot"), WorldClanNotFound);
+    std::vector<std::vector<string>> alliances = {
+            {"Al-Kharid", "Asgarnia", "Misthalin", "Newbie"},
+            {"Crandor", "Entrana"}, {"Morytania"}};
+    ASSERT_TRUE(w.getAlliances() == alliances);
+
+    /* The united clan takes the friends, and the allies, of both */
+    w.uniteClans("Misthalin", "Crandor", "Kingdom");
+    alliances = {{"Al-Kharid", "Asgarnia", "Entrana", "Kingdom", "Newbie"},
+                 {"Morytania"}};
+    ASSERT_TRUE(w.getAlliances() == alliances);
+    ASSERT_TRUE(w.areAllies("Entrana", "Newbie"));
+    w.uniteClans("Morytania", "Asgarnia", "Morytania");
+    alliances = {{"Al-Kharid", "Entrana", "Kingdom", "Morytania",
+                  "Newbie"}};
+    ASSERT_TRUE(w.getAlliances() == alliances);
+    w.addClan("Camelot");
+    ASSERT_FALSE(w.areAllies("Camelot", "Kingdom"));
+    return true;
+}
+
 int main(){
     RUN_TEST(testWorld);
+    RUN_TEST(testWorldAlliances);
     return 0;
 }
\ No newline at end of file